@@ -0,0 +1,124 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <sstream>
+
+#include <Corpus.hpp>
+
+
+namespace {
+
+void appendBase64(std::string &body, const std::string &data) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t column = 0;
+    for (size_t k = 0; k < data.size(); k += 3) {
+        unsigned bits = (unsigned char)data[k] << 16;
+        if (k + 1 < data.size()) bits |= (unsigned char)data[k + 1] << 8;
+        if (k + 2 < data.size()) bits |= (unsigned char)data[k + 2];
+        body += alphabet[bits >> 18];
+        body += alphabet[(bits >> 12) & 63];
+        body += (k + 1 < data.size()) ? alphabet[(bits >> 6) & 63] : '=';
+        body += (k + 2 < data.size()) ? alphabet[bits & 63] : '=';
+        if ((column += 4) == 76 && k + 3 < data.size()) {
+            body += "\r\n";
+            column = 0;
+        }
+    }
+}
+
+}
+
+Corpus generateCorpus(const CorpusSpec &spec) {
+    static const char bchars[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ'()+_,-./:=?";
+    std::mt19937 rng(spec.seed);
+    std::uniform_real_distribution<double> probability(0.0, 1.0);
+
+    Corpus result;
+    result.parts = spec.parts;
+    for (size_t k = 0; k < spec.boundaryLength; k++) {
+        result.boundary += bchars[rng() % (sizeof(bchars) - 1)];
+    }
+    if (spec.boundary) result.boundary = spec.boundary;
+
+    std::string delimiter = "\r\n--" + result.boundary;
+    std::string nearMiss = delimiter;
+    nearMiss.back() = (nearMiss.back() == 'x') ? 'y' : 'x';
+
+    std::string &body = result.body;
+    body.reserve(spec.parts * (spec.partSize + 128));
+    for (size_t n = 0; n < spec.parts; n++) {
+        body += ((n == 0) ? delimiter.substr(2) : delimiter) + "\r\nContent-Type: application/octet-stream\r\n";
+        if (spec.base64) {
+            body += "Content-Transfer-Encoding: base64\r\n\r\n";
+            std::string data(spec.partSize, '\0');
+            for (char &c : data) c = (char)(rng() & 0xFF);
+            appendBase64(body, data);
+            continue;
+        }
+        body += "\r\n";
+        size_t start = body.size();
+        while (body.size() - start < spec.partSize) {
+            if (spec.nearBoundary > 0 && probability(rng) < spec.nearBoundary && body.size() - start + nearMiss.size() <= spec.partSize) {
+                body += nearMiss;
+                continue;
+            }
+            if (probability(rng) < spec.crDensity) {
+                body += '\r';
+                continue;
+            }
+            char c;
+            do {
+                c = (char)(rng() & 0xFF);
+            } while (c == '\r');
+            body += c;
+        }
+        // Random content must not contain the delimiter:
+        size_t pos = start;
+        while ((pos = body.find(delimiter, pos)) != std::string::npos) {
+            body[pos + 2] = 'x';
+        }
+    }
+    body += delimiter + "--";
+
+    return result;
+}
+
+std::string describe(const CorpusSpec &spec) {
+    std::ostringstream ss;
+    ss << spec.parts << "x" << spec.partSize << " b" << spec.boundaryLength << " cr" << spec.crDensity << " near" << spec.nearBoundary;
+    if (spec.base64) ss << " base64";
+    return ss.str();
+}
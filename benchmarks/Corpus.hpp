@@ -0,0 +1,75 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+
+
+/**
+* Synthetic multipart body description
+*/
+struct CorpusSpec {
+    size_t parts = 1;
+    size_t partSize = 1 << 20;
+    size_t boundaryLength = 15;
+    double crDensity = 1.0 / 256; // probability of CR for each part byte
+    double nearBoundary = 0;      // probability of a delimiter near miss ("\r\n--" + boundary but last character) for each part byte
+    bool base64 = false;          // part content (of partSize bytes) base64 encoded in lines of 76 characters
+    unsigned seed = 2022;
+    const char *boundary = nullptr; // fixed boundary (otherwise, random of boundaryLength characters)
+};
+
+/**
+* Generated multipart body
+*/
+struct Corpus {
+    std::string boundary;
+    std::string body;
+    size_t parts;
+};
+
+/**
+* Generates a well-formed body of octet-stream parts with random binary content
+* (CR density and near misses do not apply to base64 parts)
+*
+* @param spec Body description
+*/
+Corpus generateCorpus(const CorpusSpec &spec);
+
+/**
+* Short text for the description (i.e. "4x1024 b15 cr0.0039 near0")
+*/
+std::string describe(const CorpusSpec &spec);
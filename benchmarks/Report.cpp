@@ -0,0 +1,96 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <Report.hpp>
+
+
+namespace {
+
+std::string quoted(const std::string &text) {
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+}
+
+void Report::print(std::ostream &os, Format format) const {
+
+    if (format == Csv) {
+        for (const auto &property : properties_) {
+            os << "# " << property.first << ": " << property.second << '\n';
+        }
+        os << "suite,variant,corpus,chunk,mb_per_s,parts_per_s,allocations" << '\n';
+        for (const Result &r : results_) {
+            os << r.suite << ',' << r.variant << ',' << r.corpus << ',' << r.chunk << ',' << r.mbps << ',' << r.partsps << ',' << r.allocations << '\n';
+        }
+        return;
+    }
+
+    if (format == Json) {
+        os << "{" << '\n';
+        for (const auto &property : properties_) {
+            os << "  " << quoted(property.first) << ": " << quoted(property.second) << "," << '\n';
+        }
+        os << "  \"results\": [" << '\n';
+        for (size_t k = 0; k < results_.size(); k++) {
+            const Result &r = results_[k];
+            os << "    { \"suite\": " << quoted(r.suite) << ", \"variant\": " << quoted(r.variant) << ", \"corpus\": " << quoted(r.corpus)
+               << ", \"chunk\": " << r.chunk << ", \"mb_per_s\": " << r.mbps << ", \"parts_per_s\": " << r.partsps
+               << ", \"allocations\": " << r.allocations << " }" << ((k + 1 < results_.size()) ? "," : "") << '\n';
+        }
+        os << "  ]" << '\n' << "}" << '\n';
+        return;
+    }
+
+    for (const auto &property : properties_) {
+        os << property.first << ": " << property.second << '\n';
+    }
+    std::string suite;
+    for (const Result &r : results_) {
+        if (r.suite != suite) {
+            suite = r.suite;
+            os << '\n' << "[" << suite << "]" << '\n';
+        }
+        os << "  " << r.corpus;
+        if (r.chunk) os << " chunk " << r.chunk;
+        os << " | " << r.variant << ": " << r.mbps << " MB/s, " << r.partsps << " parts/s";
+        if (r.allocations >= 0) os << ", " << r.allocations << " allocations/op";
+        os << '\n';
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/**
+* Benchmark measurement
+*/
+struct Result {
+    std::string suite;     // i.e. "parser"
+    std::string variant;   // i.e. "simd"
+    std::string corpus;    // corpus description
+    size_t chunk = 0;      // feed chunk size (0: whole body)
+    double mbps = 0;       // MB/s (1e6 bytes per second)
+    double partsps = 0;    // parts per second
+    double allocations = -1; // heap allocations per operation (-1: not measured)
+};
+
+/**
+* Benchmark results, printed as text, CSV or JSON
+*/
+class Report {
+    std::vector<Result> results_;
+    std::vector<std::pair<std::string, std::string>> properties_;
+
+public:
+    enum Format { Text, Csv, Json };
+
+    /**
+    * Adds a property of the run (i.e. "isa", "avx2")
+    */
+    void property(const std::string &name, const std::string &value) {
+        properties_.emplace_back(name, value);
+    }
+
+    void add(const Result &result) {
+        results_.push_back(result);
+    }
+
+    void print(std::ostream &os, Format format) const;
+};
@@ -0,0 +1,625 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Standard
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+#include <ert/multipart/Consumer.hpp>
+#include <ert/multipart/BasicConsumer.hpp>
+#include <ert/multipart/ConsumerPool.hpp>
+#include <ert/multipart/DecoderEngine.hpp>
+#include <ert/multipart/FixedBoundary.hpp>
+#include <ert/multipart/ParallelDecoder.hpp>
+#include <ert/multipart/Producer.hpp>
+#include <ert/multipart/Rewriter.hpp>
+#include <ert/multipart/TransferDecoder.hpp>
+
+#include <Corpus.hpp>
+#include <Report.hpp>
+
+using namespace ert::multipart;
+
+// Heap allocations counter (not inlined: the compiler would see mismatched malloc()/delete and new/free() pairs):
+static std::atomic<size_t> Allocations(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr, size_t) noexcept {
+    free(ptr);
+}
+
+namespace {
+
+// Minimum measurement time for each case:
+double Seconds = 0.2;
+
+struct Matcher {
+    multipart_matcher id;
+    const char *name;
+};
+
+const Matcher Matchers[] = {
+    { MULTIPART_MATCHER_BYTE, "byte" },
+    { MULTIPART_MATCHER_SIMD, "simd" },
+    { MULTIPART_MATCHER_HORSPOOL, "horspool" }
+};
+
+int CountData(multipart_parser* p, const char *at, size_t length) {
+    *(size_t*)multipart_parser_get_data(p) += length;
+    return 0;
+}
+
+// Repeats the operation until the minimum measurement time is reached, and returns the number of operations per second
+template <class Operation>
+double rate(Operation operation) {
+    auto start = std::chrono::steady_clock::now();
+    size_t iterations = 0;
+    std::chrono::duration<double> elapsed{};
+    do {
+        operation();
+        iterations++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < Seconds);
+
+    return iterations / elapsed.count();
+}
+
+Result result(const char *suite, const char *variant, const CorpusSpec &spec, const Corpus &corpus, double operations, size_t chunk = 0) {
+    Result r;
+    r.suite = suite;
+    r.variant = variant;
+    r.corpus = describe(spec);
+    r.chunk = chunk;
+    r.mbps = operations * corpus.body.size() / 1e6;
+    r.partsps = operations * corpus.parts;
+    return r;
+}
+
+// Same work behind virtual and static dispatch:
+class VirtualConsumer : public Consumer {
+public:
+    size_t bytes = 0;
+    VirtualConsumer(const std::string &boundary) : Consumer(boundary) {;}
+    void receiveHeaderView(std::string_view name, std::string_view value) override {
+        bytes += name.size() + value.size();
+    }
+    void receiveDataView(std::string_view data) override {
+        bytes += data.size();
+    }
+};
+
+class StaticConsumer : public BasicConsumer<StaticConsumer> {
+public:
+    size_t bytes = 0;
+    StaticConsumer(const std::string &boundary) : BasicConsumer(boundary) {;}
+    void receiveHeaderView(std::string_view name, std::string_view value) {
+        bytes += name.size() + value.size();
+    }
+    void receiveDataView(std::string_view data) {
+        bytes += data.size();
+    }
+};
+
+// multipart_parser_execute with every delimiter matcher
+void runParser(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+    multipart_parser_settings settings{};
+    settings.on_part_data = CountData;
+
+    for (const Matcher &matcher : Matchers) {
+        size_t total = 0;
+        double operations = rate([&]() {
+            multipart_parser* parser = multipart_parser_init(corpus.boundary.c_str(), &settings);
+            multipart_parser_set_matcher(parser, matcher.id);
+            multipart_parser_set_data(parser, &total);
+            multipart_parser_execute(parser, corpus.body.data(), corpus.body.size());
+            multipart_parser_free(parser);
+        });
+        if (total == 0) std::cerr << "Nothing decoded !" << '\n';
+        report.add(result("parser", matcher.name, spec, corpus, operations));
+    }
+}
+
+// Boundary of the fixed boundary suite (the one of examples/main.cpp):
+constexpr char FixedBoundary[] = "7MA4YWxkTrZu0gW";
+
+struct DataCounter : ParserHandler {
+    size_t total = 0;
+    int onPartData(const char *at, size_t length) {
+        total += length;
+        return 0;
+    }
+};
+
+// Runtime boundary against the compile-time one (multipart_parser_execute_fixed) for the scanning matchers
+void runFixed(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+    multipart_parser parser;
+    multipart_parser_construct(&parser, FixedBoundary, nullptr);
+    DataCounter counter;
+
+    for (const Matcher &matcher : Matchers) {
+        if (matcher.id == MULTIPART_MATCHER_BYTE) continue;
+        multipart_parser_set_matcher(&parser, matcher.id);
+        std::string runtime = std::string("runtime ") + matcher.name;
+        report.add(result("fixed boundary", runtime.c_str(), spec, corpus, rate([&]() {
+            multipart_parser_reset(&parser, FixedBoundary);
+            multipart_parser_execute(&parser, counter, corpus.body.data(), corpus.body.size());
+        })));
+        std::string fixed = std::string("fixed ") + matcher.name;
+        report.add(result("fixed boundary", fixed.c_str(), spec, corpus, rate([&]() {
+            multipart_parser_reset(&parser, FixedBoundary);
+            multipart_parser_execute_fixed<FixedBoundary>(&parser, counter, corpus.body.data(), corpus.body.size());
+        })));
+    }
+    multipart_parser_destroy(&parser);
+
+    if (counter.total == 0) std::cerr << "Nothing decoded !" << '\n';
+}
+
+template <class T>
+double measureConsumer(const Corpus &corpus, size_t chunk) {
+    T consumer(corpus.boundary);
+    const char *data = corpus.body.data();
+    size_t size = corpus.body.size();
+
+    double operations = rate([&]() {
+        consumer.reset(corpus.boundary);
+        for (size_t offset = 0; offset < size; offset += chunk) {
+            consumer.feed(data + offset, std::min(chunk, size - offset));
+        }
+        consumer.finish();
+    });
+
+    if (consumer.bytes == 0) std::cerr << "Nothing decoded !" << '\n';
+    return operations;
+}
+
+// Consumer::decode (virtual) against BasicConsumer (static) on the whole body
+void runConsumer(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+    VirtualConsumer consumer(corpus.boundary);
+    double operations = rate([&]() {
+        consumer.reset(corpus.boundary);
+        consumer.decode(corpus.body);
+        consumer.finish();
+    });
+    if (consumer.bytes == 0) std::cerr << "Nothing decoded !" << '\n';
+    report.add(result("consumer", "virtual", spec, corpus, operations));
+    report.add(result("consumer", "static", spec, corpus, measureConsumer<StaticConsumer>(corpus, corpus.body.size())));
+}
+
+// Incremental feeding through the chunk sizes given
+void runChunked(Report &report, const CorpusSpec &spec, std::initializer_list<size_t> chunks) {
+    Corpus corpus = generateCorpus(spec);
+    for (size_t chunk : chunks) {
+        report.add(result("chunked", "virtual", spec, corpus, measureConsumer<VirtualConsumer>(corpus, chunk), chunk));
+    }
+}
+
+// Copying consumer (default std::string adapters) interested in the first part only
+class FirstPartConsumer : public Consumer {
+public:
+    size_t part = 0;
+    size_t bytes = 0;
+    bool filter = false;
+    FirstPartConsumer(const std::string &boundary) : Consumer(boundary) {;}
+    bool acceptPart() override {
+        return (part++ == 0 || !filter);
+    }
+    void receiveData(const std::string &data) override {
+        bytes += data.size();
+    }
+};
+
+// Skipping the data of ignored parts
+void runFilter(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+    FirstPartConsumer consumer(corpus.boundary);
+
+    for (bool filter : { false, true }) {
+        consumer.filter = filter;
+        report.add(result("filter", filter ? "first part" : "all parts", spec, corpus, rate([&]() {
+            consumer.reset(corpus.boundary);
+            consumer.part = 0;
+            consumer.decode(corpus.body);
+            consumer.finish();
+        })));
+    }
+}
+
+// Base64 parts: delivered encoded, decoded in the same pass, or decoded afterwards from the coalesced part
+void runTransfer(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+
+    class TransferConsumer : public BasicConsumer<TransferConsumer> {
+    public:
+        bool decodeAfter = false;
+        TransferDecoder decoder;
+        std::string decoded;
+        size_t bytes = 0;
+        TransferConsumer(const std::string &boundary) : BasicConsumer(boundary) {;}
+        void receiveDataView(std::string_view data) {
+            if (decodeAfter) {
+                decoded.resize(TransferDecoder::bound(data.size()));
+                decoder.reset(TransferEncoding::Base64);
+                bytes += decoder.decode(data.data(), data.size(), &decoded[0]);
+                return;
+            }
+            bytes += data.size();
+        }
+    } consumer(corpus.boundary);
+
+    auto measure = [&](const char *variant) {
+        report.add(result("transfer", variant, spec, corpus, rate([&]() {
+            consumer.reset(corpus.boundary);
+            consumer.feed(corpus.body.data(), corpus.body.size());
+            consumer.finish();
+        })));
+    };
+
+    measure("encoded");
+    consumer.setTransferDecoding(true);
+    measure("streaming decode");
+    consumer.setTransferDecoding(false);
+    consumer.setCoalescedParts(true);
+    consumer.decodeAfter = true;
+    measure("decode after");
+}
+
+// Serial parser against the parallel decoder, in document order and order-agnostic
+void runParallel(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+
+    struct Counter : ParserHandler {
+        std::atomic<size_t> bytes{0};
+        int onPartData(const char *at, size_t length) {
+            bytes.fetch_add(length, std::memory_order_relaxed);
+            return 0;
+        }
+    } counter;
+
+    multipart_parser parser;
+    multipart_parser_construct(&parser, corpus.boundary.c_str(), nullptr);
+    report.add(result("parallel", "serial", spec, corpus, rate([&]() {
+        multipart_parser_reset(&parser, corpus.boundary.c_str());
+        multipart_parser_execute(&parser, counter, corpus.body.data(), corpus.body.size());
+    })));
+    multipart_parser_destroy(&parser);
+
+    ParallelDecoder decoder;
+    report.add(result("parallel", "ordered", spec, corpus, rate([&]() {
+        decoder.execute(corpus.boundary, corpus.body.data(), corpus.body.size(), counter);
+    })));
+    decoder.setOrdered(false);
+    report.add(result("parallel", "unordered", spec, corpus, rate([&]() {
+        decoder.execute(corpus.boundary, corpus.body.data(), corpus.body.size(), counter);
+    })));
+
+    if (!decoder.completed() || counter.bytes == 0) std::cerr << "Wrong decoding !" << '\n';
+}
+
+// Concurrent streams fed by HTTP/2 sized frames, interleaved: decoded on the producer thread, or by engine shards
+void runEngine(Report &report, const CorpusSpec &spec, size_t streams) {
+    Corpus corpus = generateCorpus(spec);
+    const size_t frame = 16384;
+
+    auto interleave = [&](auto &&submit) {
+        for (size_t offset = 0; offset < corpus.body.size(); offset += frame) {
+            for (size_t stream = 0; stream < streams; stream++) {
+                submit(stream, corpus.body.data() + offset, std::min(frame, corpus.body.size() - offset));
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<StaticConsumer>> consumers;
+    for (size_t stream = 0; stream < streams; stream++) {
+        consumers.emplace_back(new StaticConsumer(corpus.boundary));
+    }
+    report.add(result("engine", "producer thread", spec, corpus, streams * rate([&]() {
+        for (auto &consumer : consumers) consumer->reset(corpus.boundary);
+        interleave([&](size_t stream, const char *data, size_t length) {
+            consumers[stream]->feed(data, length);
+        });
+        for (auto &consumer : consumers) consumer->finish();
+    }), frame));
+
+    std::vector<size_t> shardCounts{ 1 };
+    if (std::thread::hardware_concurrency() > 1) shardCounts.push_back(std::thread::hardware_concurrency());
+
+    std::atomic<size_t> incomplete{0};
+    for (size_t shards : shardCounts) {
+        DecoderEngine<StaticConsumer> engine(shards);
+        engine.setCloseHandler([&](uint64_t, StaticConsumer &, bool complete) {
+            if (!complete) incomplete++;
+        });
+        std::string variant = std::to_string(shards) + " shard" + (shards > 1 ? "s" : "");
+        report.add(result("engine", variant.c_str(), spec, corpus, streams * rate([&]() {
+            for (size_t stream = 0; stream < streams; stream++) engine.open(stream, corpus.boundary);
+            interleave([&](size_t stream, const char *data, size_t length) {
+                engine.submit(stream, data, length);
+            });
+            for (size_t stream = 0; stream < streams; stream++) engine.close(stream);
+            engine.flush();
+        }), frame));
+    }
+    if (incomplete) std::cerr << "Wrong decoding !" << '\n';
+}
+
+// Batch of small bodies sharing the boundary: consumer per body, reset per body, and batch decoding (serial and on every worker)
+void runBatch(Report &report, const CorpusSpec &spec, size_t bodies) {
+    Corpus corpus = generateCorpus(spec);
+    std::vector<std::string_view> batch(bodies, corpus.body);
+
+    report.add(result("batch", "consumer per body", spec, corpus, bodies * rate([&]() {
+        for (std::string_view body : batch) {
+            StaticConsumer consumer(corpus.boundary);
+            consumer.feed(body.data(), body.size());
+            consumer.finish();
+        }
+    })));
+
+    StaticConsumer consumer(corpus.boundary);
+    report.add(result("batch", "reset per body", spec, corpus, bodies * rate([&]() {
+        for (std::string_view body : batch) {
+            consumer.reset(corpus.boundary);
+            consumer.feed(body.data(), body.size());
+            consumer.finish();
+        }
+    })));
+
+    for (size_t threads : { (size_t)1, (size_t)0 }) {
+        ParallelDecoder decoder(threads);
+        std::vector<std::unique_ptr<StaticConsumer>> owned;
+        std::vector<StaticConsumer*> consumers;
+        for (size_t worker = 0; worker < decoder.workers(); worker++) {
+            owned.emplace_back(new StaticConsumer(corpus.boundary));
+            consumers.push_back(owned.back().get());
+        }
+        std::string variant = "batch, " + std::to_string(decoder.workers()) + " worker" + (decoder.workers() > 1 ? "s" : "");
+        size_t incomplete = 0;
+        report.add(result("batch", variant.c_str(), spec, corpus, bodies * rate([&]() {
+            for (const DecodeResult &body : decoder.decodeBatch(corpus.boundary, batch.data(), batch.size(), consumers)) {
+                if (body.status != DecodeStatus::Complete) incomplete++;
+            }
+        })));
+        if (incomplete) std::cerr << "Wrong decoding !" << '\n';
+        if (decoder.workers() == 1) break; // no other worker count
+    }
+}
+
+// Steady state decoding through pooled consumers must not allocate
+void runAllocations(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+
+    auto decode = [&]() {
+        auto consumer = ConsumerPool<VirtualConsumer>::acquire(corpus.boundary);
+        consumer->decode(corpus.body);
+        consumer->finish();
+    };
+
+    decode(); // warm up
+    size_t decodes = 0;
+    size_t before = Allocations.load(std::memory_order_relaxed);
+    double operations = rate([&]() {
+        decode();
+        decodes++;
+    });
+    double allocations = (double)(Allocations.load(std::memory_order_relaxed) - before) / decodes;
+
+    if (allocations > 0) std::cerr << "Allocations after warm up !" << '\n';
+
+    Result r = result("pool", "virtual", spec, corpus, operations);
+    r.allocations = allocations;
+    report.add(r);
+}
+
+// Encoding to a reused string and to scatter-gather buffers
+void runProducer(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+    std::string content(spec.partSize, 'x');
+    Producer producer;
+    for (size_t n = 0; n < spec.parts; n++) producer.addPart({{"Content-Type", "application/octet-stream"}}, content);
+    std::string output;
+    size_t buffers = 0;
+
+    // Throughput is computed over the encoded size, which is close to the corpus one:
+    corpus.body.resize(producer.size());
+    report.add(result("producer", "string", spec, corpus, rate([&]() {
+        producer.encode(output);
+    })));
+    report.add(result("producer", "iovecs", spec, corpus, rate([&]() {
+        buffers += producer.iovecs().size();
+    })));
+
+    if (output.size() != producer.size() || buffers == 0) std::cerr << "Wrong encoding !" << '\n';
+}
+
+// Copies every part, to encode them again:
+class CopyConsumer : public BasicConsumer<CopyConsumer> {
+public:
+    std::vector<std::vector<std::pair<std::string, std::string>>> headers;
+    std::vector<std::string> bodies;
+    CopyConsumer(const std::string &boundary) : BasicConsumer(boundary) {;}
+    void receiveHeaderView(std::string_view name, std::string_view value) {
+        if (headers.size() == bodies.size()) headers.emplace_back();
+        headers.back().emplace_back(name, value);
+    }
+    void receiveDataView(std::string_view data) {
+        if (bodies.size() < headers.size()) bodies.emplace_back();
+        bodies.back().append(data.data(), data.size());
+    }
+};
+
+// Replacing the body of one part: decoding and encoding again against Rewriter
+void runRewriter(Report &report, const CorpusSpec &spec) {
+    Corpus corpus = generateCorpus(spec);
+    std::string replacement(spec.partSize, 'r');
+    size_t size = 0;
+
+    report.add(result("rewrite", "decode and encode", spec, corpus, rate([&]() {
+        CopyConsumer consumer(corpus.boundary);
+        consumer.feed(corpus.body.data(), corpus.body.size());
+        Producer producer(corpus.boundary);
+        for (size_t n = 0; n < consumer.bodies.size(); n++) {
+            std::vector<Producer::Header> headers(consumer.headers[n].begin(), consumer.headers[n].end());
+            producer.addPart(headers, (n == 1) ? std::string_view(replacement) : std::string_view(consumer.bodies[n]));
+        }
+        size += producer.encode().size();
+    })));
+
+    Rewriter rewriter;
+    size_t buffers = 0;
+    report.add(result("rewrite", "rewriter iovecs", spec, corpus, rate([&]() {
+        rewriter.load(corpus.body, corpus.boundary);
+        rewriter.replaceBody(1, replacement);
+        buffers += rewriter.iovecs().size();
+    })));
+
+    if (size == 0 || buffers == 0 || rewriter.parts() != spec.parts) std::cerr << "Wrong rewriting !" << '\n';
+}
+
+CorpusSpec spec(size_t parts, size_t partSize, size_t boundaryLength = 15, double crDensity = 1.0 / 256, double nearBoundary = 0) {
+    CorpusSpec result;
+    result.parts = parts;
+    result.partSize = partSize;
+    result.boundaryLength = boundaryLength;
+    result.crDensity = crDensity;
+    result.nearBoundary = nearBoundary;
+    return result;
+}
+
+CorpusSpec fixedSpec(size_t parts, size_t partSize, double crDensity = 1.0 / 256) {
+    CorpusSpec result = spec(parts, partSize, sizeof(FixedBoundary) - 1, crDensity);
+    result.boundary = FixedBoundary;
+    return result;
+}
+
+CorpusSpec base64Spec(size_t parts, size_t partSize) {
+    CorpusSpec result = spec(parts, partSize);
+    result.base64 = true;
+    return result;
+}
+
+void usage(const char *progname) {
+    std::cerr << "Usage: " << progname << " [--format text|csv|json] [--seconds <minimum time per case>]" << '\n';
+}
+
+}
+
+int main(int argc, char* argv[]) {
+
+    Report::Format format = Report::Text;
+    for (int k = 1; k < argc; k++) {
+        std::string option = argv[k];
+        if (option == "--format" && k + 1 < argc) {
+            std::string value = argv[++k];
+            if (value == "csv") format = Report::Csv;
+            else if (value == "json") format = Report::Json;
+            else if (value != "text") {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (option == "--seconds" && k + 1 < argc) {
+            Seconds = std::stod(argv[++k]);
+        }
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Report report;
+    report.property("isa", multipart_parser_scan_isa());
+    report.property("base64 isa", TransferDecoder::isa());
+    report.property("tracing", multipart_parser_tracing());
+    report.property("threads", std::to_string(std::thread::hardware_concurrency()));
+
+    // Delimiter scanning: part size, boundary length, CR density and near misses
+    runParser(report, spec(1, 1 << 20));
+    runParser(report, spec(1, 1 << 20, 70));
+    runParser(report, spec(1, 1 << 20, 15, 1.0 / 16));
+    runParser(report, spec(1, 1 << 20, 15, 1.0 / 256, 1.0 / 1024));
+    runParser(report, spec(1, 1 << 20, 70, 1.0 / 256, 1.0 / 1024));
+    // Part count:
+    runParser(report, spec(100, 1024));
+    runParser(report, spec(1000, 16));
+
+    // Compile-time boundary: binary data, CR dense data and part count
+    runFixed(report, fixedSpec(1, 1 << 20));
+    runFixed(report, fixedSpec(1, 1 << 20, 1.0 / 16));
+    runFixed(report, fixedSpec(100, 1024));
+
+    runConsumer(report, spec(1, 1 << 20));
+    runConsumer(report, spec(1000, 16));
+
+    runFilter(report, spec(8, 1 << 16));
+
+    runTransfer(report, base64Spec(4, 1 << 18));
+
+    runChunked(report, spec(16, 1 << 16), { 16, 256, 4096, 16384, 65536 });
+
+    runParallel(report, spec(256, 1 << 16));
+    runParallel(report, spec(4096, 1024));
+
+    runEngine(report, spec(4, 1 << 16), 256);
+
+    runBatch(report, spec(4, 64), 1024);
+
+    runAllocations(report, spec(4, 64));
+
+    runProducer(report, spec(4, 1 << 20));
+
+    runRewriter(report, spec(4, 1 << 20));
+
+    report.print(std::cout, format);
+
+    return 0;
+}
@@ -38,6 +38,7 @@ SOFTWARE.
 #include <signal.h>
 
 // Standard
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <unistd.h>
@@ -47,6 +48,7 @@ SOFTWARE.
 #include <ert/tracing/Logger.hpp>
 
 #include <ert/multipart/Consumer.hpp>
+#include <ert/multipart/MultipartView.hpp>
 
 const char* progname;
 
@@ -149,5 +151,22 @@ int main(int argc, char* argv[]) {
     consumer.decode(body);
     std::cout << std::endl;
 
+    // Same body received in chunks (i.e. HTTP/2 DATA frames), reusing the consumer:
+    std::cout << std::endl << "=== Body multipart decoded by 8-byte chunks ===" << std::endl;
+    consumer.reset("7MA4YWxkTrZu0gW");
+    for (size_t offset = 0; offset < body.size(); offset += 8) {
+        consumer.feed(body.data() + offset, std::min((size_t)8, body.size() - offset));
+    }
+    std::cout << "Complete: " << (consumer.finish() ? "yes":"no") << std::endl;
+
+    // Pull-style iteration, stopping at the part needed:
+    std::cout << std::endl << "=== JSON part found with MultipartView ===" << std::endl;
+    for (const ert::multipart::Part &part : ert::multipart::MultipartView(body, "7MA4YWxkTrZu0gW")) {
+        if (part.header("content-type") == "application/json") {
+            std::cout << part.body << std::endl;
+            break;
+        }
+    }
+
     return 0;
 }
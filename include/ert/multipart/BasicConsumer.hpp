@@ -0,0 +1,832 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <string.h>
+#include <strings.h>
+
+#include <ert/multipart/DecodeResult.hpp>
+#include <ert/multipart/FileReader.hpp>
+#include <ert/multipart/HeaderId.hpp>
+#include <ert/multipart/Metrics.hpp>
+#include <ert/multipart/Parser.hpp>
+#include <ert/multipart/TransferDecoder.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+class ParallelDecoder;
+
+/**
+* Multipart decoder with statically dispatched callbacks (CRTP)
+*
+* Derived class implements (publicly) the callbacks which are needed:
+*
+* @code
+* class MyConsumer : public ert::multipart::BasicConsumer<MyConsumer> {
+* public:
+*     MyConsumer(const std::string &boundary) : BasicConsumer(boundary) {;}
+*     void receiveHeaderView(std::string_view name, std::string_view value) { ... }
+*     void receiveDataView(std::string_view data) { ... }
+* };
+* @endcode
+*
+* Callbacks are called directly from the parser state machine, so the compiler
+* can inline them.
+*
+* The body may be decoded in chunks as they arrive (feed(), finish()). Chunks may
+* be split at any byte: data is delivered as it comes, while headers are delivered
+* once and whole. Use reset() to decode another body with the same object: parser
+* state is embedded and header buffers keep their capacity, so decoding with a
+* reused consumer does not allocate (see ConsumerPool).
+*
+* Parts which are multipart themselves (i.e. multipart/mixed inside multipart/form-data)
+* may be decoded in the same pass, up to a maximum depth (see setMaxDepth()): their
+* inner parts are delivered instead of their data, and depth() tells the nesting
+* level. Memory is bounded by the depth, not by the size of the nested bodies.
+*
+* Base64 and quoted-printable part data may also be decoded on the fly (see
+* setTransferDecoding()), so data callbacks receive the original content.
+*
+* Untrusted bodies may be bounded (see setLimits()): decoding stops at the first
+* violation, and result() tells which one and where.
+*/
+template <class Derived>
+class BasicConsumer {
+
+    template <class Boundary, class Handler>
+    friend size_t multipart_parser_execute_with(multipart_parser* p, Handler& handler, const char *buf, size_t len);
+    friend class ParallelDecoder;
+
+    // Parser hooks:
+    int onPartDataBegin() {
+        if (++parts_ > limits_.parts) {
+            return violate(DecodeStatus::TooManyParts);
+        }
+        header_bytes_ = 0;
+        part_bytes_ = 0;
+        return 0;
+    }
+    int onHeaderField(const char *at, size_t length);
+    int onHeaderValue(const char *at, size_t length);
+    int onHeadersComplete() {
+        clearHeader();
+        bool nested = nested_pending_;
+        nested_pending_ = false;
+        TransferEncoding encoding = part_encoding_;
+        part_encoding_ = TransferEncoding::Identity;
+        part_decoding_ = false;
+        ERT_MULTIPART_METRIC(metrics_->add(Metrics::Parts); part_size_ = 0);
+        if (!derived().acceptPart()) {
+            ERT_MULTIPART_METRIC(metrics_->add(Metrics::SkippedParts));
+            return MULTIPART_SKIP_PART;
+        }
+        if (nested) {
+            return pushNested();
+        }
+        part_active_ = true;
+        if (encoding != TransferEncoding::Identity) {
+            transfer_decoder_.reset(encoding);
+            part_decoding_ = true;
+        }
+        if (coalesced_) {
+            part_open_ = true;
+            part_begin_ = nullptr;
+            part_length_ = 0;
+            part_accumulated_ = (level_ > 0 || part_decoding_); // data may come from parser or decoder buffers
+            if (part_accumulated_) part_storage_.clear();
+        }
+        return 0;
+    }
+    int onPartData(const char *at, size_t length) {
+        if (level_ < depth_) {
+            return feedNested(at, length);
+        }
+        if ((part_bytes_ += length) > limits_.partSize) {
+            return violate(DecodeStatus::PartTooLarge);
+        }
+        if (part_decoding_) {
+            if (decoded_storage_.size() < TransferDecoder::bound(length)) {
+                decoded_storage_.resize(TransferDecoder::bound(length));
+            }
+            size_t decoded = transfer_decoder_.decode(at, length, &decoded_storage_[0]);
+            deliverData(decoded_storage_.data(), decoded);
+            return 0;
+        }
+        deliverData(at, length);
+        return 0;
+    }
+    void deliverData(const char *at, size_t length) {
+        ERT_MULTIPART_METRIC(part_size_ += length);
+        if (!coalesced_) {
+            ERT_MULTIPART_METRIC(metrics_->add(Metrics::Callbacks));
+            derived().receiveDataView(std::string_view(at, length));
+        }
+        else if (part_accumulated_) {
+            part_storage_.append(at, length);
+        }
+        else {
+            if (!part_begin_) part_begin_ = at; // first fragment always starts in the chunk
+            part_length_ += length;
+        }
+    }
+    int onPartDataEnd() {
+        if (level_ < depth_) {
+            return popNested();
+        }
+        if (!part_active_) { // skipped
+            return 0;
+        }
+        part_active_ = false;
+        if (part_decoding_) {
+            part_decoding_ = false;
+            if (decoded_storage_.size() < TransferDecoder::bound(0)) {
+                decoded_storage_.resize(TransferDecoder::bound(0));
+            }
+            size_t decoded = transfer_decoder_.finish(&decoded_storage_[0]);
+            if (decoded) deliverData(decoded_storage_.data(), decoded);
+        }
+        if (coalesced_ && part_open_) {
+            part_open_ = false;
+            ERT_MULTIPART_METRIC(metrics_->add(Metrics::Callbacks));
+            derived().receivePartView(part_accumulated_ ? std::string_view(part_storage_) : std::string_view(part_begin_, part_length_));
+        }
+        ERT_MULTIPART_METRIC(metrics_->add(Metrics::Callbacks); metrics_->partSize().observe(part_size_));
+        derived().receivePartEnd();
+        return 0;
+    }
+    int onBodyEnd() {
+        return 0;
+    }
+
+    Derived& derived() {
+        return static_cast<Derived&>(*this);
+    }
+
+    int violate(DecodeStatus status) {
+        violation_ = status;
+        failed_ = true;
+        return -1;
+    }
+
+    void clearHeader();
+    void keepHeaderName();
+    int pushNested();
+    int feedNested(const char *at, size_t length);
+    int popNested();
+    void rearm();
+    size_t allowance(size_t length) const;
+    void parsedChunk(size_t length, size_t allowed, size_t parsed);
+    void metricsChunkBegin();
+    void metricsChunkEnd(size_t length, size_t parsed);
+
+    multipart_parser parser_;
+
+    const char *chunk_end_;
+    bool armed_;  // parser armed with the boundary given (allocation may fail for long ones)
+    bool failed_;
+    size_t parsed_; // bytes of the body parsed
+
+    // Resource limits, and usage of the body (parts) and of the current part:
+    DecodeLimits limits_;
+    DecodeStatus violation_; // reason of the failure
+    size_t parts_;
+    size_t header_bytes_;
+    size_t part_bytes_;
+
+    std::string_view header_name_; // points into the chunk, or to storage below
+    std::string header_name_storage_;
+    std::string header_value_storage_;
+    bool header_name_partial_;
+    bool header_value_partial_;
+
+    // Coalesced parts: span within the chunk, or accumulated when the part crosses chunks
+    bool part_active_; // accepted part, not ended
+    bool coalesced_;
+    bool part_open_;
+    bool part_accumulated_;
+    const char *part_begin_;
+    size_t part_length_;
+    std::string part_storage_;
+
+    // Nested multipart parts: parser for the data of the part open at each level
+    std::vector<std::unique_ptr<multipart_parser>> nested_;
+    size_t depth_; // nested parsers active
+    size_t level_; // level of the parser calling the hooks
+    size_t max_depth_;
+    bool nested_pending_; // current part is multipart, with this boundary:
+    std::string nested_boundary_;
+
+    // Content-Transfer-Encoding decoding:
+    bool transfer_decoding_;
+    TransferEncoding part_encoding_; // from current part headers
+    bool part_decoding_; // current part data goes through the decoder
+    TransferDecoder transfer_decoder_;
+    std::string decoded_storage_;
+
+#if ERT_MULTIPART_METRICS
+    Metrics *metrics_;
+    size_t body_offset_; // bytes fed since reset (or finish)
+    size_t part_size_;
+    std::chrono::steady_clock::time_point decode_start_;
+#endif
+
+public:
+
+    /**
+    * Default constructor
+    *
+    * @param boundary Multipart boundary string (the consumer is failed if it cannot be armed)
+    */
+    BasicConsumer(const std::string& boundary);
+    ~BasicConsumer();
+
+    BasicConsumer(const BasicConsumer&) = delete;
+    BasicConsumer& operator=(const BasicConsumer&) = delete;
+
+    /**
+    * Decode next body chunk
+    *
+    * May be called repeatedly with consecutive chunks of the body.
+    *
+    * @param data Chunk content
+    * @param length Chunk length
+    *
+    * @return false if the body is malformed (then, further chunks are ignored until reset)
+    */
+    bool feed(const char *data, size_t length);
+
+    /**
+    * Decode body stored in a file descriptor, from its current offset to the end
+    *
+    * Regular files are memory mapped and decoded at once: views delivered refer
+    * to the mapping, so no copy of the body is made whatever its size. Pipes and
+    * sockets are decoded in blocks as they are read (see readFd()).
+    *
+    * @param fd File descriptor, open for reading (not closed)
+    *
+    * @return false if the file can not be read, or the body is malformed
+    */
+    bool decodeFd(int fd) {
+        return (readFd(fd, [this](const char *data, size_t length) {
+            return feed(data, length);
+        }) && !failed_);
+    }
+
+    /**
+    * Decode body stored in a file (see decodeFd())
+    *
+    * @param path File path
+    *
+    * @return false if the file can not be opened or read, or the body is malformed
+    */
+    bool decodeFile(const std::string& path) {
+        return (readFile(path, [this](const char *data, size_t length) {
+            return feed(data, length);
+        }) && !failed_);
+    }
+
+    /**
+    * Indicates that no more chunks will be fed
+    *
+    * @return true if the whole body (up to the closing delimiter) has been decoded
+    */
+    bool finish();
+
+    /**
+    * Rearms the consumer to decode a new body, reusing its resources
+    *
+    * @param boundary Multipart boundary string
+    *
+    * @return false if the boundary cannot be armed (a long one, whose storage cannot
+    * be allocated): the consumer stays failed until reset with another boundary
+    */
+    bool reset(const std::string& boundary);
+
+    /**
+    * Rearms the consumer to decode a new body with the same boundary, keeping the
+    * parser delimiter tables (cheaper than reset() when bodies share the boundary)
+    */
+    void rewind();
+
+    /**
+    * @return bytes of the body parsed since the consumer was reset: on malformed
+    * bodies, the position of the error
+    */
+    size_t offset() const {
+        return parsed_;
+    }
+
+    /**
+    * Result of the decoding so far (after finish(), of the whole body)
+    *
+    * @return status (Complete, Incomplete, or the reason why decoding stopped),
+    * offset of the body where it stopped, and the parser state reached
+    */
+    DecodeResult result() const;
+
+    /**
+    * Sets the resource limits checked while decoding (unlimited by default)
+    *
+    * Limits are kept across reset() and rewind().
+    *
+    * @param limits Resource limits (see DecodeLimits)
+    */
+    void setLimits(const DecodeLimits& limits) {
+        limits_ = limits;
+    }
+
+    /**
+    * @return resource limits checked while decoding
+    */
+    const DecodeLimits& limits() const {
+        return limits_;
+    }
+
+    /**
+    * Enables or disables coalesced parts delivery (disabled by default)
+    *
+    * When enabled, each part data is delivered once and whole through
+    * receivePartView() instead of fragments through receiveDataView(). Parts
+    * contained within a fed chunk are delivered as a view into it, without
+    * copies; parts crossing chunks are accumulated in a single buffer, which
+    * keeps its capacity for the next ones.
+    *
+    * @param enable Coalesced parts mode
+    */
+    void setCoalescedParts(bool enable) {
+        coalesced_ = enable;
+        part_open_ = false;
+    }
+
+    /**
+    * Enables the decoding of nested multipart parts (disabled by default)
+    *
+    * Parts with a multipart Content-Type (and a boundary parameter) up to this
+    * nesting level are decoded, and deeper ones delivered as data.
+    *
+    * @param depth Maximum nesting depth (0: nested parts are delivered as data)
+    */
+    void setMaxDepth(size_t depth) {
+        max_depth_ = depth;
+    }
+
+    /**
+    * Enables the decoding of base64 and quoted-printable parts (disabled by default)
+    *
+    * Data of parts whose Content-Transfer-Encoding is one of them is decoded as it
+    * arrives, in a single pass, and delivered decoded (in coalesced parts mode,
+    * those parts are accumulated). Header callbacks still receive the
+    * Content-Transfer-Encoding header. Other parts are delivered as they are.
+    *
+    * @param enable Transfer decoding mode
+    */
+    void setTransferDecoding(bool enable) {
+        transfer_decoding_ = enable;
+    }
+
+    /**
+    * Sets the metrics recorded by the consumer (none by default)
+    *
+    * Recording needs the library built with ERT_MULTIPART_Metrics enabled:
+    * otherwise, it is compiled away and this has no effect.
+    *
+    * @param metrics Metrics set, which must outlive the consumer (nullptr: no recording)
+    */
+    void setMetrics(Metrics *metrics) {
+#if ERT_MULTIPART_METRICS
+        metrics_ = metrics;
+#endif
+    }
+
+    /**
+    * Nesting level of the part whose header or data is being delivered (0 for the
+    * parts of the body), valid during callbacks
+    */
+    size_t depth() const {
+        return level_;
+    }
+
+    /**
+    * Callback for new decoded header (default does nothing)
+    *
+    * Views refer to the buffer being decoded and are only valid during the call.
+    *
+    * @param name header name (i.e. content-type)
+    * @param value header value (i.e. application/json)
+    */
+    void receiveHeaderView(std::string_view name, std::string_view value) {}
+
+    /**
+    * Callback for new decoded header, identified (default delivers it through receiveHeaderView())
+    *
+    * Well-known names (see HeaderId) are identified case insensitively, so consumers
+    * can dispatch on the identifier instead of comparing names.
+    *
+    * @param id header identifier (HeaderId::Unknown for other names)
+    * @param name header name as received (i.e. Content-Type)
+    * @param value header value (i.e. application/json)
+    */
+    void receiveHeaderIdView(HeaderId id, std::string_view name, std::string_view value) {
+        derived().receiveHeaderView(name, value);
+    }
+
+    /**
+    * Part filter, called once the part headers have been received (default accepts every part)
+    *
+    * Data of rejected parts is not delivered: the parser only searches for the next
+    * delimiter.
+    *
+    * @return false to skip the part data
+    */
+    bool acceptPart() {
+        return true;
+    }
+
+    /**
+    * Callback for new decoded data part (default does nothing)
+    *
+    * The view refers to the buffer being decoded and is only valid during the call.
+    *
+    * @param data Body data
+    */
+    void receiveDataView(std::string_view data) {}
+
+    /**
+    * Callback for complete part data, in coalesced parts mode (default delivers it through receiveDataView())
+    *
+    * The view is only valid during the call.
+    *
+    * @param data Whole part data
+    */
+    void receivePartView(std::string_view data) {
+        derived().receiveDataView(data);
+    }
+
+    /**
+    * Callback for the end of part data (default does nothing)
+    *
+    * Called once the data of each accepted part has been delivered, so consumers
+    * storing it somewhere may complete it.
+    */
+    void receivePartEnd() {}
+
+    /**
+    * Callback for the consumer being rearmed by reset() or rewind() (default does nothing)
+    *
+    * Called before a new body is decoded, so consumers holding data of a part in
+    * progress may discard it.
+    */
+    void receiveRearm() {}
+};
+
+template <class Derived>
+BasicConsumer<Derived>::BasicConsumer(const std::string& boundary)
+{
+    armed_ = (multipart_parser_construct(&parser_, boundary.c_str(), nullptr) == 0);
+
+    chunk_end_ = nullptr;
+    failed_ = !armed_;
+    parsed_ = 0;
+    violation_ = DecodeStatus::Malformed;
+    parts_ = 0;
+    header_bytes_ = 0;
+    part_bytes_ = 0;
+    part_active_ = false;
+    coalesced_ = false;
+    part_open_ = false;
+    depth_ = 0;
+    level_ = 0;
+    max_depth_ = 0;
+    nested_pending_ = false;
+    transfer_decoding_ = false;
+    part_encoding_ = TransferEncoding::Identity;
+    part_decoding_ = false;
+#if ERT_MULTIPART_METRICS
+    metrics_ = nullptr;
+    body_offset_ = 0;
+    part_size_ = 0;
+#endif
+    clearHeader();
+}
+
+template <class Derived>
+BasicConsumer<Derived>::~BasicConsumer()
+{
+    multipart_parser_destroy(&parser_);
+    for (auto &nested : nested_) {
+        multipart_parser_destroy(nested.get());
+    }
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::clearHeader()
+{
+    header_name_ = std::string_view();
+    header_name_partial_ = false;
+    header_value_partial_ = false;
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::keepHeaderName()
+{
+    // A header name still waiting for its value must survive the buffer:
+    if (!header_name_.empty() && header_name_.data() != header_name_storage_.data()) {
+        header_name_storage_.assign(header_name_.data(), header_name_.size());
+        header_name_ = header_name_storage_;
+    }
+}
+
+template <class Derived>
+int BasicConsumer<Derived>::pushNested()
+{
+    if (depth_ == nested_.size()) {
+        nested_.emplace_back(new multipart_parser);
+        multipart_parser_construct(nested_.back().get(), "", nullptr);
+    }
+    multipart_parser *nested = nested_[depth_].get();
+    if (multipart_parser_reset(nested, nested_boundary_.c_str()) != 0) {
+        failed_ = true;
+        return -1;
+    }
+    nested->matcher = parser_.matcher;
+    depth_++;
+    return 0;
+}
+
+template <class Derived>
+int BasicConsumer<Derived>::feedNested(const char *at, size_t length)
+{
+    size_t level = level_++;
+    const char *chunk_end = chunk_end_;
+    chunk_end_ = at + length; // the fragment is the chunk for the nested parser
+
+    if (multipart_parser_execute(nested_[level].get(), *this, at, length) != length) {
+        failed_ = true;
+    }
+
+    chunk_end_ = chunk_end;
+    level_ = level;
+    keepHeaderName(); // fragment may be a parser buffer
+
+    return failed_ ? -1 : 0;
+}
+
+template <class Derived>
+int BasicConsumer<Derived>::popNested()
+{
+    // Nested body must be complete when its part ends:
+    depth_ = level_;
+    if (!multipart_parser_completed(nested_[level_].get())) {
+        failed_ = true;
+        return -1;
+    }
+    return 0;
+}
+
+template <class Derived>
+int BasicConsumer<Derived>::onHeaderField(const char *at, size_t length)
+{
+    if ((header_bytes_ += length) > limits_.headerBytes) {
+        return violate(DecodeStatus::HeaderTooLarge);
+    }
+
+    if (at + length == chunk_end_) { // continues in the next chunk
+        if (!header_name_partial_) {
+            header_name_storage_.clear();
+            header_name_partial_ = true;
+        }
+        header_name_storage_.append(at, length);
+        return 0;
+    }
+
+    if (header_name_partial_) {
+        header_name_storage_.append(at, length);
+        header_name_ = header_name_storage_;
+        header_name_partial_ = false;
+    }
+    else {
+        header_name_ = std::string_view(at, length);
+    }
+
+    return 0;
+}
+
+template <class Derived>
+int BasicConsumer<Derived>::onHeaderValue(const char *at, size_t length)
+{
+    if ((header_bytes_ += length) > limits_.headerBytes) {
+        return violate(DecodeStatus::HeaderTooLarge);
+    }
+
+    if (at + length == chunk_end_) { // continues in the next chunk
+        if (!header_value_partial_) {
+            header_value_storage_.clear();
+            header_value_partial_ = true;
+        }
+        header_value_storage_.append(at, length);
+        return 0;
+    }
+
+    std::string_view value(at, length);
+    if (header_value_partial_) {
+        header_value_storage_.append(at, length);
+        header_value_partial_ = false;
+        value = header_value_storage_;
+    }
+
+    HeaderId id = headerId(header_name_);
+    ERT_MULTIPART_METRIC(metrics_->add(Metrics::Headers); metrics_->add(Metrics::Callbacks));
+    derived().receiveHeaderIdView(id, header_name_, value);
+    header_name_ = std::string_view();
+
+    if (id == HeaderId::ContentTransferEncoding && transfer_decoding_) {
+        part_encoding_ = transferEncoding(value);
+    }
+    else if (id == HeaderId::ContentType && level_ < max_depth_ && value.size() > 10 && strncasecmp(value.data(), "multipart/", 10) == 0) {
+        std::string_view boundary = headerParameter(value, "boundary");
+        if (!boundary.empty()) {
+            if (level_ >= limits_.depth) {
+                return violate(DecodeStatus::TooDeep);
+            }
+            nested_boundary_.assign(boundary.data(), boundary.size());
+            nested_pending_ = true;
+        }
+    }
+
+    return 0;
+}
+
+template <class Derived>
+bool BasicConsumer<Derived>::reset(const std::string& boundary)
+{
+    armed_ = (multipart_parser_reset(&parser_, boundary.c_str()) == 0);
+    rearm();
+    return armed_;
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::rewind()
+{
+    multipart_parser_rewind(&parser_);
+    rearm();
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::rearm()
+{
+    derived().receiveRearm();
+    failed_ = !armed_;
+    parsed_ = 0;
+    violation_ = DecodeStatus::Malformed;
+    parts_ = 0;
+    header_bytes_ = 0;
+    part_bytes_ = 0;
+    depth_ = 0;
+    level_ = 0;
+    nested_pending_ = false;
+    part_active_ = false;
+    part_encoding_ = TransferEncoding::Identity;
+    part_decoding_ = false;
+#if ERT_MULTIPART_METRICS
+    body_offset_ = 0;
+#endif
+    clearHeader();
+}
+
+template <class Derived>
+size_t BasicConsumer<Derived>::allowance(size_t length) const
+{
+    // Body size limit: parse up to it, and fail there
+    return (length > limits_.bodySize - parsed_) ? limits_.bodySize - parsed_ : length;
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::parsedChunk(size_t length, size_t allowed, size_t parsed)
+{
+    if (parsed != allowed) {
+        failed_ = true; // hooks may also set it (nested bodies, limits)
+    }
+    else if (allowed != length) {
+        violate(DecodeStatus::BodyTooLarge);
+    }
+    parsed_ += parsed;
+}
+
+template <class Derived>
+DecodeResult BasicConsumer<Derived>::result() const
+{
+    DecodeResult result;
+    result.status = failed_ ? violation_ : (parser_.state == s_end ? DecodeStatus::Complete : DecodeStatus::Incomplete);
+    result.offset = parsed_;
+    result.state = parser_.state;
+    return result;
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::metricsChunkBegin()
+{
+#if ERT_MULTIPART_METRICS
+    if (metrics_ && body_offset_ == 0) {
+        decode_start_ = std::chrono::steady_clock::now();
+    }
+#endif
+}
+
+template <class Derived>
+void BasicConsumer<Derived>::metricsChunkEnd(size_t length, size_t parsed)
+{
+#if ERT_MULTIPART_METRICS
+    if (metrics_) {
+        metrics_->add(Metrics::Bytes, length);
+        if (failed_) {
+            metrics_->add(Metrics::Errors);
+            metrics_->errorOffset().observe(body_offset_ + parsed);
+        }
+    }
+    body_offset_ += length;
+#endif
+}
+
+template <class Derived>
+bool BasicConsumer<Derived>::feed(const char *data, size_t length)
+{
+    if (failed_) {
+        return false;
+    }
+
+    metricsChunkBegin();
+    size_t allowed = allowance(length);
+    chunk_end_ = data + allowed;
+    size_t parsed = multipart_parser_execute(&parser_, *this, data, allowed);
+    parsedChunk(length, allowed, parsed);
+    chunk_end_ = nullptr;
+    metricsChunkEnd(length, parsed);
+
+    keepHeaderName();
+
+    // So does the data of a coalesced part still open:
+    if (part_open_ && !part_accumulated_) {
+        part_storage_.assign(part_begin_ ? part_begin_ : "", part_length_);
+        part_accumulated_ = true;
+    }
+
+    return !failed_;
+}
+
+template <class Derived>
+bool BasicConsumer<Derived>::finish()
+{
+    clearHeader();
+    part_active_ = false;
+    part_open_ = false;
+    ERT_MULTIPART_METRIC(metrics_->add(Metrics::Decodes); if (body_offset_) metrics_->latency().observe(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - decode_start_).count()));
+#if ERT_MULTIPART_METRICS
+    body_offset_ = 0;
+#endif
+    return (!failed_ && multipart_parser_completed(&parser_));
+}
+
+}
+}
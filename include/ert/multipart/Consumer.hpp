@@ -36,8 +36,9 @@ SOFTWARE.
 #pragma once
 
 #include <string>
-#include <stdlib.h>
-#include <ctype.h>
+#include <string_view>
+
+#include <ert/multipart/BasicConsumer.hpp>
 
 
 namespace ert
@@ -45,60 +46,101 @@ namespace ert
 namespace multipart
 {
 
-typedef struct multipart_parser multipart_parser;
-typedef struct multipart_parser_settings multipart_parser_settings;
-typedef struct multipart_parser_state multipart_parser_state;
-
-typedef int (*multipart_data_cb) (multipart_parser*, const char *at, size_t length);
-typedef int (*multipart_notify_cb) (multipart_parser*);
-
-struct multipart_parser_settings {
-    multipart_data_cb on_header_field;
-    multipart_data_cb on_header_value;
-    multipart_data_cb on_part_data;
-
-    multipart_notify_cb on_part_data_begin;
-    multipart_notify_cb on_headers_complete;
-    multipart_notify_cb on_part_data_end;
-    multipart_notify_cb on_body_end;
-};
+/**
+* Multipart decoder with virtual callbacks
+*
+* The body may be decoded at once (decode()) or in chunks as they arrive (feed(),
+* finish()), see BasicConsumer. Use BasicConsumer directly to have callbacks
+* statically dispatched.
+*/
+class Consumer : public BasicConsumer<Consumer> {
 
-multipart_parser* multipart_parser_init
-(const char *boundary, const multipart_parser_settings* settings);
+public:
 
-void multipart_parser_free(multipart_parser* p);
+    /**
+    * Default constructor
+    *
+    * @param boundary Multipart boundary string
+    */
+    Consumer(const std::string& boundary);
+    virtual ~Consumer();
 
-size_t multipart_parser_execute(multipart_parser* p, const char *buf, size_t len);
+    /**
+    * Decode body multipart: the whole body, fed and finished (see feed(), finish())
+    *
+    * @param body Body content
+    *
+    * @return decoding result (see result())
+    */
+    DecodeResult decode(const std::string& body);
 
-void multipart_parser_set_data(multipart_parser* p, void* data);
-void *multipart_parser_get_data(multipart_parser* p);
+    /**
+    * Callback for new decoded header, without copies
+    *
+    * Views refer to the buffer being decoded and are only valid during the call.
+    * Default implementation adapts to the std::string overload.
+    *
+    * @param name header name (i.e. content-type)
+    * @param value header value (i.e. application/json)
+    */
+    virtual void receiveHeaderView(std::string_view name, std::string_view value);
 
-class Consumer {
-    static int ReadHeaderName(multipart_parser* p, const char *at, size_t length);
-    static int ReadHeaderValue(multipart_parser* p, const char *at, size_t length);
-    static int ReadData(multipart_parser* p, const char *at, size_t length);
+    /**
+    * Callback for new decoded header, identified (see HeaderId), without copies
+    *
+    * Views are only valid during the call.
+    * Default implementation delivers it through receiveHeaderView().
+    *
+    * @param id header identifier (HeaderId::Unknown for other names)
+    * @param name header name as received (i.e. Content-Type)
+    * @param value header value (i.e. application/json)
+    */
+    virtual void receiveHeaderIdView(HeaderId id, std::string_view name, std::string_view value);
 
-    multipart_parser* parser_;
-    multipart_parser_settings callbacks_;
+    /**
+    * Part filter, called once the part headers have been received
+    *
+    * Data of rejected parts is not delivered (nor copied): the parser only searches
+    * for the next delimiter. Default implementation accepts every part.
+    *
+    * @return false to skip the part data
+    */
+    virtual bool acceptPart();
 
-    std::string last_header_name_;
+    /**
+    * Callback for new decoded data part, without copies
+    *
+    * The view refers to the buffer being decoded and is only valid during the call.
+    * Default implementation adapts to the std::string overload.
+    *
+    * @param data Body data
+    */
+    virtual void receiveDataView(std::string_view data);
 
-public:
+    /**
+    * Callback for complete part data, in coalesced parts mode (see setCoalescedParts())
+    *
+    * The view is only valid during the call.
+    * Default implementation delivers it through receiveDataView().
+    *
+    * @param data Whole part data
+    */
+    virtual void receivePartView(std::string_view data);
 
     /**
-    * Default constructor
+    * Callback for the end of part data
     *
-    * @param boundary Multipart boundary string
+    * Called once the data of each accepted part has been delivered.
+    * Default implementation does nothing.
     */
-    Consumer(const std::string& boundary);
-    ~Consumer();
+    virtual void receivePartEnd();
 
     /**
-    * Decode body multipart
+    * Callback for the consumer being rearmed by reset() or rewind()
     *
-    * @param body Body content
+    * Default implementation does nothing.
     */
-    void decode(const std::string& body);
+    virtual void receiveRearm();
 
     /**
     * Callback for new decoded header
@@ -106,16 +148,18 @@ public:
     * @param name header name (i.e. content-type)
     * @param value header value (i.e. application/json)
     */
-    virtual void receiveHeader(const std::string &name, const std::string &value) = 0;
+    virtual void receiveHeader(const std::string &name, const std::string &value) {}
 
     /**
     * Callback for new decoded data part
     *
     * @param data Body data
     */
-    virtual void receiveData(const std::string &data) = 0;
+    virtual void receiveData(const std::string &data) {}
 };
 
+// Built into the library:
+extern template class BasicConsumer<Consumer>;
+
 }
 }
-
@@ -0,0 +1,129 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Per-thread pool of consumers
+*
+* Consumers are handed out re-armed for the requested boundary, and go back to
+* the pool of the releasing thread when the handle is destroyed. Once the pool
+* is warm, acquiring and decoding does not allocate.
+*
+* @code
+* auto consumer = ert::multipart::ConsumerPool<MyConsumer>::acquire(boundary);
+* consumer->decode(body);
+* @endcode
+*
+* Type T must be constructible from the boundary (followed by any extra
+* arguments given on acquire) and provide reset(boundary), as Consumer and
+* BasicConsumer do.
+*/
+template <class T>
+class ConsumerPool {
+
+    struct Idle {
+        std::vector<std::unique_ptr<T>> consumers;
+        size_t capacity = 16;
+    };
+
+    static Idle& idle() {
+        thread_local Idle pool;
+        return pool;
+    }
+
+public:
+
+    struct Release {
+        void operator()(T* consumer) const {
+            Idle& pool = idle();
+            if (pool.consumers.size() < pool.capacity) {
+                pool.consumers.emplace_back(consumer);
+            }
+            else {
+                delete consumer;
+            }
+        }
+    };
+
+    using Handle = std::unique_ptr<T, Release>;
+
+    /**
+    * Consumer ready to decode a new body, reused from the calling thread pool when available
+    * (failed if the boundary cannot be armed, see BasicConsumer::reset())
+    *
+    * @param boundary Multipart boundary string
+    * @param args Extra constructor arguments, used when a new consumer must be created
+    */
+    template <class... Args>
+    static Handle acquire(const std::string& boundary, Args&&... args) {
+        Idle& pool = idle();
+        if (pool.consumers.empty()) {
+            return Handle(new T(boundary, std::forward<Args>(args)...));
+        }
+
+        T* consumer = pool.consumers.back().release();
+        pool.consumers.pop_back();
+        consumer->reset(boundary);
+        return Handle(consumer);
+    }
+
+    /**
+    * Maximum number of idle consumers kept by the calling thread (16 by default)
+    *
+    * @param capacity Idle consumers limit
+    */
+    static void setCapacity(size_t capacity) {
+        Idle& pool = idle();
+        pool.capacity = capacity;
+        if (pool.consumers.size() > capacity) {
+            pool.consumers.resize(capacity);
+        }
+        pool.consumers.reserve(capacity);
+    }
+};
+
+}
+}
@@ -0,0 +1,95 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Outcome of a body decoding
+*/
+enum class DecodeStatus : unsigned char {
+    Complete,       // whole body decoded, up to the closing delimiter
+    Incomplete,     // no error so far, but the closing delimiter has not been reached
+    Malformed,      // body does not follow the multipart syntax (or a nested body is incomplete)
+    TooManyParts,   // DecodeLimits::parts exceeded
+    HeaderTooLarge, // DecodeLimits::headerBytes exceeded
+    PartTooLarge,   // DecodeLimits::partSize exceeded
+    BodyTooLarge,   // DecodeLimits::bodySize exceeded
+    TooDeep         // DecodeLimits::depth exceeded
+};
+
+/**
+* Printable name of a decode status (i.e. "PartTooLarge")
+*/
+const char *decodeStatusName(DecodeStatus status);
+
+/**
+* Decoding result: status, and where decoding stopped
+*/
+struct DecodeResult {
+    DecodeStatus status;
+    size_t offset;       // bytes of the body parsed: on errors, position where decoding stopped
+    unsigned char state; // parser state reached (see multipart_state_name())
+
+    bool ok() const {
+        return (status == DecodeStatus::Complete || status == DecodeStatus::Incomplete);
+    }
+};
+
+/**
+* Resource limits for untrusted bodies (unlimited by default)
+*
+* Decoding stops at the first violation, before the offending data is delivered,
+* so oversized or abusive bodies are rejected without spending memory nor time on
+* the rest of them. Parts and sizes of nested bodies count as those of the body.
+*/
+struct DecodeLimits {
+    size_t parts = SIZE_MAX;       // parts of the body (accepted or skipped)
+    size_t headerBytes = SIZE_MAX; // header names and values of a part
+    size_t partSize = SIZE_MAX;    // data of a part, as received (before transfer decoding)
+    size_t bodySize = SIZE_MAX;    // whole body
+    size_t depth = SIZE_MAX;       // nesting of multipart parts (0: none), when decoded (see setMaxDepth())
+};
+
+}
+}
@@ -0,0 +1,384 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/multipart/ConsumerPool.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Multipart decoding engine for many concurrent streams (i.e. HTTP/2 streams)
+*
+* Streams are pinned to one of a fixed set of worker shards by their identifier,
+* so the chunks of a stream are decoded in order by the same thread, while
+* different streams are decoded in parallel. Events reach each shard through a
+* lock-free single producer queue: the engine must be fed from a single thread
+* (i.e. the connection I/O thread; use an engine per producer thread otherwise).
+*
+* Each shard keeps the consumers of its open streams, taken from (and given back
+* to) the shard thread ConsumerPool, and reuses the stream table entries of the
+* closed streams, so decoding does not allocate once warm:
+*
+* @code
+* ert::multipart::DecoderEngine<MyConsumer> engine(4);
+* engine.setCloseHandler([](uint64_t stream, MyConsumer &consumer, bool complete) { ... });
+* engine.open(stream, boundary);
+* engine.submit(stream, data, length); // as DATA frames arrive
+* engine.close(stream);
+* @endcode
+*
+* Consumer callbacks, and open and close handlers, run on the shard threads.
+* Type T is a Consumer or BasicConsumer (see ConsumerPool requirements).
+*/
+template <class T>
+class DecoderEngine {
+
+public:
+
+    typedef std::function<void(uint64_t stream, T &consumer)> OpenHandler;
+    typedef std::function<void(uint64_t stream, T &consumer, bool complete)> CloseHandler;
+
+private:
+
+    enum Kind { Open, Data, Close };
+
+    struct Event {
+        Kind kind;
+        uint64_t stream;
+        std::string data; // boundary (Open) or chunk (Data), keeps its capacity in the queue slot
+    };
+
+    // Bounded single producer, single consumer ring
+    struct Shard {
+        std::unique_ptr<Event[]> slots;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head; // next slot to consume
+        alignas(64) std::atomic<size_t> tail; // next slot to produce
+        alignas(64) std::atomic<bool> sleeping;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> stop_;
+    OpenHandler open_handler_;
+    CloseHandler close_handler_;
+
+    Shard &shard(uint64_t stream) {
+        // HTTP/2 stream identifiers share parity: mix them before taking the shard
+        uint64_t hash = stream * 0x9E3779B97F4A7C15ull;
+        return *shards_[(hash >> 32) % shards_.size()];
+    }
+
+    Event &reserve(Shard &shard);
+    void publish(Shard &shard);
+    void loop(Shard &shard);
+
+public:
+
+    /**
+    * Constructor, starting the shard threads
+    *
+    * @param shards Number of worker shards (0: hardware concurrency)
+    * @param capacity Events queued per shard (rounded up to a power of two)
+    */
+    DecoderEngine(size_t shards = 0, size_t capacity = 1024);
+
+    /**
+    * Destructor: queued events are processed, then the streams still open are
+    * discarded (close handler is not called for them)
+    */
+    ~DecoderEngine();
+
+    DecoderEngine(const DecoderEngine&) = delete;
+    DecoderEngine& operator=(const DecoderEngine&) = delete;
+
+    /**
+    * Sets the handler called when a stream consumer is ready, before its first chunk
+    * (i.e. to configure it). Must be set before the first stream is open.
+    */
+    void setOpenHandler(const OpenHandler &handler) {
+        open_handler_ = handler;
+    }
+
+    /**
+    * Sets the handler called when a stream is closed, with the result of its
+    * finish(). The consumer is given back to the pool on return. Must be set
+    * before the first stream is open.
+    */
+    void setCloseHandler(const CloseHandler &handler) {
+        close_handler_ = handler;
+    }
+
+    /**
+    * @return number of worker shards
+    */
+    size_t shards() const {
+        return shards_.size();
+    }
+
+    /**
+    * Opens a stream (a stream already open is restarted)
+    *
+    * @param stream Stream identifier
+    * @param boundary Multipart boundary string
+    */
+    void open(uint64_t stream, const std::string &boundary);
+
+    /**
+    * Submits the next chunk of a stream body
+    *
+    * Chunk is copied into the queue, so it may be released on return. When the
+    * shard queue is full, waits for room (back pressure on the producer).
+    *
+    * @param stream Stream identifier (chunks of unknown streams are ignored)
+    * @param data Chunk content
+    * @param length Chunk length
+    */
+    void submit(uint64_t stream, const char *data, size_t length);
+
+    /**
+    * Closes a stream, once its chunks have been decoded (see setCloseHandler())
+    *
+    * @param stream Stream identifier
+    */
+    void close(uint64_t stream);
+
+    /**
+    * Waits until every event submitted has been processed
+    */
+    void flush();
+};
+
+template <class T>
+DecoderEngine<T>::DecoderEngine(size_t shards, size_t capacity)
+{
+    if (shards == 0) {
+        shards = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t slots = 2;
+    while (slots < capacity) slots <<= 1;
+
+    stop_ = false;
+    for (size_t k = 0; k < shards; k++) {
+        std::unique_ptr<Shard> shard(new Shard);
+        shard->slots.reset(new Event[slots]);
+        shard->mask = slots - 1;
+        shard->head = 0;
+        shard->tail = 0;
+        shard->sleeping = false;
+        shards_.push_back(std::move(shard));
+    }
+    for (auto &shard : shards_) {
+        Shard *s = shard.get();
+        s->thread = std::thread([this, s]() {
+            loop(*s);
+        });
+    }
+}
+
+template <class T>
+DecoderEngine<T>::~DecoderEngine()
+{
+    stop_.store(true);
+    for (auto &shard : shards_) {
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+        }
+        shard->wake.notify_one();
+        shard->thread.join();
+    }
+}
+
+template <class T>
+typename DecoderEngine<T>::Event &DecoderEngine<T>::reserve(Shard &shard)
+{
+    size_t tail = shard.tail.load(std::memory_order_relaxed);
+    while (tail - shard.head.load(std::memory_order_acquire) > shard.mask) {
+        std::this_thread::yield(); // full
+    }
+    return shard.slots[tail & shard.mask];
+}
+
+template <class T>
+void DecoderEngine<T>::publish(Shard &shard)
+{
+    // Worker is only woken when it sleeps: sequentially consistent tail store and
+    // sleeping load, against the sleeping store and tail load in loop()
+    shard.tail.store(shard.tail.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    if (shard.sleeping.load(std::memory_order_seq_cst)) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+        }
+        shard.wake.notify_one();
+    }
+}
+
+template <class T>
+void DecoderEngine<T>::open(uint64_t stream, const std::string &boundary)
+{
+    Shard &s = shard(stream);
+    Event &event = reserve(s);
+    event.kind = Open;
+    event.stream = stream;
+    event.data.assign(boundary);
+    publish(s);
+}
+
+template <class T>
+void DecoderEngine<T>::submit(uint64_t stream, const char *data, size_t length)
+{
+    Shard &s = shard(stream);
+    Event &event = reserve(s);
+    event.kind = Data;
+    event.stream = stream;
+    event.data.assign(data, length);
+    publish(s);
+}
+
+template <class T>
+void DecoderEngine<T>::close(uint64_t stream)
+{
+    Shard &s = shard(stream);
+    Event &event = reserve(s);
+    event.kind = Close;
+    event.stream = stream;
+    publish(s);
+}
+
+template <class T>
+void DecoderEngine<T>::flush()
+{
+    for (auto &shard : shards_) {
+        size_t tail = shard->tail.load(std::memory_order_relaxed);
+        while (shard->head.load(std::memory_order_acquire) != tail) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <class T>
+void DecoderEngine<T>::loop(Shard &shard)
+{
+    typedef std::unordered_map<uint64_t, typename ConsumerPool<T>::Handle> Streams;
+    Streams streams;
+    std::vector<typename Streams::node_type> entries; // of closed streams, reused
+    unsigned spins = 0;
+
+    for (;;) {
+        size_t head = shard.head.load(std::memory_order_relaxed);
+        if (head == shard.tail.load(std::memory_order_acquire)) {
+            if (++spins < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Sleep until the producer publishes (or the engine stops):
+            shard.sleeping.store(true, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                shard.wake.wait(lock, [&]() {
+                    return stop_.load() || head != shard.tail.load(std::memory_order_seq_cst);
+                });
+            }
+            shard.sleeping.store(false, std::memory_order_relaxed);
+            if (head == shard.tail.load(std::memory_order_acquire)) {
+                break; // stopped, and nothing left
+            }
+            continue;
+        }
+        spins = 0;
+
+        Event &event = shard.slots[head & shard.mask];
+        switch (event.kind) {
+        case Open: {
+            auto it = streams.find(event.stream);
+            if (it == streams.end()) {
+                if (entries.empty()) {
+                    it = streams.emplace(event.stream, nullptr).first;
+                }
+                else {
+                    entries.back().key() = event.stream;
+                    it = streams.insert(std::move(entries.back())).position;
+                    entries.pop_back();
+                }
+            }
+            it->second = ConsumerPool<T>::acquire(event.data);
+            if (open_handler_) open_handler_(event.stream, *it->second);
+            break;
+        }
+        case Data: {
+            auto it = streams.find(event.stream);
+            if (it != streams.end()) {
+                it->second->feed(event.data.data(), event.data.size());
+            }
+            break;
+        }
+        case Close: {
+            auto it = streams.find(event.stream);
+            if (it != streams.end()) {
+                bool complete = it->second->finish();
+                if (close_handler_) close_handler_(event.stream, *it->second, complete);
+                entries.push_back(streams.extract(it));
+                entries.back().mapped().reset(); // consumer back to the pool
+            }
+            break;
+        }
+        }
+
+        shard.head.store(head + 1, std::memory_order_release);
+    }
+}
+
+}
+}
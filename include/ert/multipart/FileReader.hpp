@@ -0,0 +1,84 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <functional>
+#include <string>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Receiver of file content: returns false to stop reading
+*/
+typedef std::function<bool(const char *data, size_t length)> FileSink;
+
+/**
+* Size of the reads for files which can not be mapped
+*/
+const size_t FileReadSize = 1 << 20;
+
+/**
+* Reads a file descriptor from its current offset to the end
+*
+* Regular files are memory mapped and given to the sink at once, without copies
+* (the mapping is released when the sink returns). Other files (pipes, sockets,
+* character devices) are read in blocks of FileReadSize, each given as read.
+*
+* @param fd File descriptor, open for reading (not closed)
+* @param sink File content receiver
+*
+* @return false if the file can not be read, or the sink stops the reading
+*/
+bool readFd(int fd, const FileSink &sink);
+
+/**
+* Reads a whole file (see readFd())
+*
+* @param path File path
+* @param sink File content receiver
+*
+* @return false if the file can not be opened or read, or the sink stops the reading
+*/
+bool readFile(const std::string &path, const FileSink &sink);
+
+}
+}
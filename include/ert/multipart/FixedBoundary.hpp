@@ -0,0 +1,257 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <array>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ERT_MULTIPART_FIXED_X86
+#include <immintrin.h>
+#endif
+
+#include <ert/multipart/Parser.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+// Compile-time delimiter tables (see multipart_fixed_boundary):
+
+template <const char *Boundary>
+constexpr size_t multipart_fixed_size() {
+    size_t result = 0;
+    while (Boundary[result]) result++;
+    return result;
+}
+
+template <const char *Boundary>
+constexpr std::array<char, multipart_fixed_size<Boundary>() + 4> multipart_fixed_delimiter() {
+    std::array<char, multipart_fixed_size<Boundary>() + 4> result{};
+    result[0] = 13;
+    result[1] = 10;
+    result[2] = '-';
+    result[3] = '-';
+    for (size_t k = 0; k < multipart_fixed_size<Boundary>(); k++) result[4 + k] = Boundary[k];
+    return result;
+}
+
+template <const char *Boundary>
+constexpr std::array<unsigned char, 256> multipart_fixed_skip() {
+    constexpr size_t length = multipart_fixed_size<Boundary>() + 4;
+    constexpr std::array<char, length> delimiter = multipart_fixed_delimiter<Boundary>();
+    std::array<unsigned char, 256> result{};
+    for (size_t c = 0; c < 256; c++) result[c] = (length < 255) ? length : 255;
+    for (size_t k = 0; k + 1 < length; k++) {
+        result[(unsigned char)delimiter[k]] = (length - 1 - k < 255) ? length - 1 - k : 255;
+    }
+    return result;
+}
+
+/**
+* Delimiter of a boundary known at compile time (see multipart_parser_execute_fixed())
+*
+* Delimiter, length and Horspool shift table are computed by the compiler, so the
+* state machine compares with constants and candidates are verified with fixed
+* size compares. Part data is scanned for the delimiter first and last bytes at once
+* (16 or 32 positions at a time with SSE2 or AVX2, selected as the runtime scan),
+* which discards almost every CR of binary data without verifying it. The
+* MULTIPART_MATCHER_HORSPOOL matcher uses the compile-time shift table.
+*/
+template <const char *Boundary>
+struct multipart_fixed_boundary {
+
+    static constexpr size_t Size = multipart_fixed_size<Boundary>();
+    static_assert(Size > 0 && Size <= MULTIPART_BOUNDARY_MAX, "boundary length out of RFC 2046 limits");
+
+    static constexpr size_t Length = Size + 2;          // "--boundary"
+    static constexpr size_t DelimiterLength = Size + 4; // "\r\n--boundary"
+    static constexpr std::array<char, DelimiterLength> Delimiter = multipart_fixed_delimiter<Boundary>();
+    static constexpr std::array<unsigned char, 256> Skip = multipart_fixed_skip<Boundary>();
+
+    static const char *boundary(const multipart_parser*) {
+        return Delimiter.data() + 2;
+    }
+    static constexpr size_t length(const multipart_parser*) {
+        return Length;
+    }
+    static size_t scan(multipart_parser* p, const char *buf, size_t len);
+
+    // Scalar scan, which also detects candidates truncated at the end of the buffer
+    static size_t scanScalar(const char *buf, size_t len);
+    static size_t scanHorspool(const char *buf, size_t len);
+#ifdef ERT_MULTIPART_FIXED_X86
+    __attribute__((target("sse2"))) static size_t scanSse2(const char *buf, size_t len);
+    __attribute__((target("avx2"))) static size_t scanAvx2(const char *buf, size_t len);
+#endif
+};
+
+template <const char *Boundary>
+size_t multipart_fixed_boundary<Boundary>::scanScalar(const char *buf, size_t len)
+{
+    const char *cr = buf;
+    const char *end = buf + len;
+    while ((cr = (const char*)memchr(cr, 13, end - cr))) {
+        size_t available = end - cr;
+        if (memcmp(cr, Delimiter.data(), (available < DelimiterLength) ? available : DelimiterLength) == 0) {
+            return cr - buf;
+        }
+        cr++;
+    }
+    return len;
+}
+
+template <const char *Boundary>
+size_t multipart_fixed_boundary<Boundary>::scanHorspool(const char *buf, size_t len)
+{
+    constexpr size_t last = DelimiterLength - 1;
+    size_t pos = 0;
+
+    while (pos + last < len) {
+        char c = buf[pos + last];
+        if (c == Delimiter[last] && memcmp(buf + pos, Delimiter.data(), last) == 0) {
+            return pos;
+        }
+        pos += Skip[(unsigned char)c];
+    }
+
+    return pos + scanScalar(buf + pos, len - pos);
+}
+
+#ifdef ERT_MULTIPART_FIXED_X86
+// Positions whose whole delimiter is within the buffer are scanned in blocks:
+// the remaining ones are left to the scalar scan.
+
+template <const char *Boundary>
+size_t multipart_fixed_boundary<Boundary>::scanSse2(const char *buf, size_t len)
+{
+    const __m128i first = _mm_set1_epi8(13);
+    const __m128i last = _mm_set1_epi8(Delimiter[DelimiterLength - 1]);
+    size_t i = 0;
+
+    while (i + DelimiterLength - 1 + 16 <= len) {
+        __m128i m = _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(buf + i)), first),
+                                  _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(buf + i + DelimiterLength - 1)), last));
+        unsigned mask = (unsigned)_mm_movemask_epi8(m);
+        while (mask) {
+            size_t pos = i + __builtin_ctz(mask);
+            if (memcmp(buf + pos, Delimiter.data(), DelimiterLength) == 0) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+
+    return i + scanScalar(buf + i, len - i);
+}
+
+template <const char *Boundary>
+size_t multipart_fixed_boundary<Boundary>::scanAvx2(const char *buf, size_t len)
+{
+    const __m256i first = _mm256_set1_epi8(13);
+    const __m256i last = _mm256_set1_epi8(Delimiter[DelimiterLength - 1]);
+    size_t i = 0;
+
+    while (i + DelimiterLength - 1 + 32 <= len) {
+        __m256i m = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + i)), first),
+                                     _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + i + DelimiterLength - 1)), last));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(m);
+        while (mask) {
+            size_t pos = i + __builtin_ctz(mask);
+            if (memcmp(buf + pos, Delimiter.data(), DelimiterLength) == 0) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+
+    return i + scanSse2(buf + i, len - i);
+}
+#endif
+
+template <const char *Boundary>
+size_t multipart_fixed_boundary<Boundary>::scan(multipart_parser* p, const char *buf, size_t len)
+{
+    if (p->matcher == MULTIPART_MATCHER_HORSPOOL) {
+        return scanHorspool(buf, len);
+    }
+#ifdef ERT_MULTIPART_FIXED_X86
+    static const bool avx2 = (strcmp(multipart_parser_scan_isa(), "avx2") == 0);
+    return avx2 ? scanAvx2(buf, len) : scanSse2(buf, len);
+#else
+    return scanScalar(buf, len);
+#endif
+}
+
+/**
+* Parses a body chunk calling the handler hooks (see ParserHandler), for a boundary
+* known at compile time
+*
+* The boundary is a constant character array with static storage, and the parser
+* must have been initialized (or reset) with the same boundary:
+*
+* @code
+* static constexpr char Boundary[] = "7MA4YWxkTrZu0gW";
+* multipart_parser_construct(&parser, Boundary, nullptr);
+* multipart_parser_execute_fixed<Boundary>(&parser, handler, data, length);
+* @endcode
+*
+* Chunks of a body may be parsed with either this or multipart_parser_execute().
+* A parser armed with other boundary is a programming error: asserted, and nothing
+* is parsed in release builds.
+*
+* @return number of bytes parsed (less than len on error or when a hook stops the parsing)
+*/
+template <const char *Boundary, class Handler>
+size_t multipart_parser_execute_fixed(multipart_parser* p, Handler& handler, const char *buf, size_t len) {
+    typedef multipart_fixed_boundary<Boundary> Fixed;
+    bool armed = (p->boundary_length == Fixed::Length && memcmp(p->multipart_boundary, Fixed::boundary(p), Fixed::Length) == 0);
+    assert(armed && "parser armed with other boundary");
+    if (!armed) {
+        return 0;
+    }
+    return multipart_parser_execute_with<Fixed>(p, handler, buf, len);
+}
+
+}
+}
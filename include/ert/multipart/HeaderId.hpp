@@ -0,0 +1,145 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <string_view>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Well-known part header names
+*/
+enum class HeaderId : unsigned char {
+    Unknown,
+    ContentType,
+    ContentId,
+    ContentDisposition,
+    ContentTransferEncoding,
+    ContentLength,
+    ContentLocation
+};
+
+/**
+* Header name character classes: lowercase letter for valid characters, 0 for invalid ones
+*/
+struct HeaderCharTable {
+    char lower[256];
+};
+
+constexpr HeaderCharTable makeHeaderCharTable() {
+    HeaderCharTable table{};
+    for (int c = 0; c < 256; c++) {
+        if ((c >= 'a' && c <= 'z') || c == '-') table.lower[c] = (char)c;
+        else if (c >= 'A' && c <= 'Z') table.lower[c] = (char)(c - 'A' + 'a');
+    }
+    return table;
+}
+
+inline constexpr HeaderCharTable HeaderChars = makeHeaderCharTable();
+
+// Lowercase names, by HeaderId:
+inline constexpr std::string_view HeaderNames[] = {
+    "", "content-type", "content-id", "content-disposition", "content-transfer-encoding", "content-length", "content-location"
+};
+
+inline constexpr size_t HeaderSlots = 32;
+
+// Hash of a header name: length and last character, case insensitive
+constexpr size_t headerHash(std::string_view name) {
+    return (name.size() + (unsigned char)HeaderChars.lower[(unsigned char)name.back()]) % HeaderSlots;
+}
+
+struct HeaderSlotTable {
+    HeaderId id[HeaderSlots];
+    bool perfect;
+};
+
+constexpr HeaderSlotTable makeHeaderSlotTable() {
+    HeaderSlotTable table{};
+    table.perfect = true;
+    for (size_t k = 1; k < sizeof(HeaderNames) / sizeof(HeaderNames[0]); k++) {
+        size_t slot = headerHash(HeaderNames[k]);
+        if (table.id[slot] != HeaderId::Unknown) table.perfect = false;
+        table.id[slot] = (HeaderId)k;
+    }
+    return table;
+}
+
+inline constexpr HeaderSlotTable HeaderSlotIds = makeHeaderSlotTable();
+static_assert(HeaderSlotIds.perfect, "well-known header names must not collide (review headerHash)");
+
+/**
+* Well-known header identification (case insensitive)
+*
+* @param name Header name (i.e. Content-Type)
+*
+* @return header identifier, HeaderId::Unknown for other names
+*/
+constexpr HeaderId headerId(std::string_view name) {
+    if (name.empty()) return HeaderId::Unknown;
+
+    HeaderId id = HeaderSlotIds.id[headerHash(name)];
+    std::string_view known = HeaderNames[(size_t)id];
+    if (known.size() != name.size()) return HeaderId::Unknown;
+    for (size_t k = 0; k < known.size(); k++) {
+        if (HeaderChars.lower[(unsigned char)name[k]] != known[k]) return HeaderId::Unknown;
+    }
+    return id;
+}
+
+/**
+* @return lowercase header name (empty for HeaderId::Unknown)
+*/
+constexpr std::string_view headerName(HeaderId id) {
+    return HeaderNames[(size_t)id];
+}
+
+/**
+* Parameter of a header value (i.e. 'boundary' from "multipart/mixed; boundary=\"x\""),
+* by name (case insensitive) and unquoted
+*
+* @return parameter value, empty if missing
+*/
+std::string_view headerParameter(std::string_view value, std::string_view name);
+
+}
+}
@@ -0,0 +1,220 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include <ert/multipart/Config.hpp> // ERT_MULTIPART_METRICS
+
+#if ERT_MULTIPART_METRICS
+#define ERT_MULTIPART_METRIC(statement)                                \
+do {                                                                   \
+  if (metrics_) {                                                      \
+    statement;                                                         \
+  }                                                                    \
+} while (0)
+#else
+#define ERT_MULTIPART_METRIC(statement)
+#endif
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Histogram with fixed buckets, lock free
+*/
+class Histogram {
+
+public:
+
+    static const size_t Buckets = 16;
+
+    /**
+    * Constructor
+    *
+    * @param bounds Bucket upper bounds (inclusive), increasing, in the recorded unit
+    * @param scale Factor from the recorded unit to the exported one (i.e. 1e-9 for nanoseconds to seconds)
+    */
+    Histogram(const uint64_t (&bounds)[Buckets], double scale = 1);
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /**
+    * Records a value
+    */
+    void observe(uint64_t value) {
+        size_t bucket = 0;
+        while (bucket < Buckets && value > bounds_[bucket]) bucket++;
+        counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+    * @return number of values recorded
+    */
+    uint64_t count() const;
+
+    /**
+    * @return sum of the values recorded
+    */
+    uint64_t sum() const {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+    /**
+    * Adds the values recorded by other histogram with the same buckets
+    */
+    void merge(const Histogram &other);
+
+    /**
+    * Appends Prometheus text exposition lines (_bucket, _sum and _count)
+    *
+    * @param name Metric name
+    * @param output Text to append to
+    */
+    void exportText(const std::string &name, std::string &output) const;
+
+private:
+
+    uint64_t bounds_[Buckets];
+    double scale_;
+    std::atomic<uint64_t> counts_[Buckets + 1]; // last one: +Inf
+    std::atomic<uint64_t> sum_;
+};
+
+/**
+* Decoding metrics: counters and histograms, lock free
+*
+* Consumers record into the metrics set (see BasicConsumer::setMetrics()) when the
+* library is built with ERT_MULTIPART_Metrics enabled; otherwise, recording is
+* compiled away and the parser pays nothing. A metrics set may be shared by
+* consumers on several threads, although one per thread avoids contention on
+* its counters: they are aggregated with merge() before exporting.
+*/
+class Metrics {
+
+public:
+
+    enum Counter {
+        Bytes,        // body bytes fed
+        Decodes,      // bodies finished
+        Parts,        // parts (including nested multipart ones)
+        SkippedParts, // parts rejected by acceptPart()
+        Headers,      // part headers
+        Callbacks,    // header, data and part callbacks
+        Errors,       // malformed bodies
+        Counters
+    };
+
+    Metrics();
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    /**
+    * Increments a counter
+    */
+    void add(Counter counter, uint64_t value = 1) {
+        counters_[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+    * @return counter value
+    */
+    uint64_t value(Counter counter) const {
+        return counters_[counter].load(std::memory_order_relaxed);
+    }
+
+    /**
+    * Decode latency, in nanoseconds, from the first chunk to finish()
+    */
+    Histogram &latency() {
+        return latency_;
+    }
+    const Histogram &latency() const {
+        return latency_;
+    }
+
+    /**
+    * Part data size, in bytes (as delivered)
+    */
+    Histogram &partSize() {
+        return part_size_;
+    }
+    const Histogram &partSize() const {
+        return part_size_;
+    }
+
+    /**
+    * Offset within the body of the decoding errors, in bytes
+    */
+    Histogram &errorOffset() {
+        return error_offset_;
+    }
+    const Histogram &errorOffset() const {
+        return error_offset_;
+    }
+
+    /**
+    * Adds the metrics recorded by other set (i.e. from other thread)
+    */
+    void merge(const Metrics &other);
+
+    /**
+    * Prometheus text exposition format
+    *
+    * @param prefix Metric names prefix
+    */
+    std::string prometheus(const std::string &prefix = "ert_multipart") const;
+
+private:
+
+    std::atomic<uint64_t> counters_[Counters];
+    Histogram latency_;
+    Histogram part_size_;
+    Histogram error_offset_;
+};
+
+}
+}
@@ -0,0 +1,173 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ert/multipart/Parser.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Multipart body part, referring to the original buffer
+*/
+struct Part {
+    std::vector<std::pair<std::string_view, std::string_view>> headers; // name, value
+    std::string_view body;
+
+    /**
+    * Header value by name (case insensitive)
+    *
+    * @param name header name (i.e. content-type)
+    *
+    * @return header value, empty if missing
+    */
+    std::string_view header(std::string_view name) const;
+
+    /**
+    * Header value by identifier (see HeaderId)
+    *
+    * @param id well-known header identifier
+    *
+    * @return header value, empty if missing
+    */
+    std::string_view header(HeaderId id) const;
+};
+
+/**
+* Pull-style access to the parts of a contiguous multipart body
+*
+* Parts are parsed lazily as the iteration advances, so it can be stopped as soon
+* as the interesting part is found. Header and body views refer to the original
+* buffer, which must outlive the view:
+*
+* @code
+* for (const ert::multipart::Part &part : ert::multipart::MultipartView(body, boundary)) {
+*     if (part.header("content-type") == "application/json") { ... break; }
+* }
+* @endcode
+*
+* This is a single pass (input) range: begin() may be called once.
+*/
+class MultipartView {
+
+    struct Handler;
+
+    bool next();
+
+    multipart_parser parser_;
+    std::string_view buffer_;
+    size_t offset_;
+    bool done_;
+    bool failed_;
+    Part part_;
+
+public:
+
+    class iterator {
+        MultipartView *view_;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Part;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Part*;
+        using reference = const Part&;
+
+        iterator(MultipartView *view = nullptr) : view_(view) {}
+
+        reference operator*() const {
+            return view_->part_;
+        }
+        pointer operator->() const {
+            return &view_->part_;
+        }
+        iterator& operator++() {
+            if (!view_->next()) view_ = nullptr;
+            return *this;
+        }
+        bool operator==(const iterator &other) const {
+            return view_ == other.view_;
+        }
+        bool operator!=(const iterator &other) const {
+            return view_ != other.view_;
+        }
+    };
+
+    /**
+    * Default constructor
+    *
+    * @param body Body content (not copied)
+    * @param boundary Multipart boundary string
+    */
+    MultipartView(std::string_view body, const std::string& boundary);
+    ~MultipartView();
+
+    MultipartView(const MultipartView&) = delete;
+    MultipartView& operator=(const MultipartView&) = delete;
+
+    iterator begin() {
+        return next() ? iterator(this) : iterator();
+    }
+    iterator end() {
+        return iterator();
+    }
+
+    /**
+    * @return true if the body is malformed (iteration stops at the first malformed part)
+    */
+    bool failed() const {
+        return failed_;
+    }
+
+    /**
+    * @return body bytes parsed so far
+    */
+    size_t position() const {
+        return offset_;
+    }
+};
+
+}
+}
@@ -0,0 +1,559 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <ert/multipart/Parser.hpp>
+#include <ert/multipart/BasicConsumer.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Multipart decoder spreading large contiguous bodies over a pool of threads
+*
+* Delimiter positions are searched in parallel over fixed-size slices of the body
+* (using the parser delimiter matcher). Then, each part is parsed by the regular
+* state machine (multipart_parser_execute()) on a worker, resuming right after its
+* delimiter, so the results match a serial decode exactly:
+*
+* @code
+* ert::multipart::ParallelDecoder decoder;
+* MyConsumer consumer(boundary);
+* decoder.decode(consumer, body.data(), body.size());
+* consumer.finish();
+* @endcode
+*
+* By default, parser hooks fire in document order from the calling thread, once
+* the corresponding parts have been parsed. In order-agnostic mode (see setOrdered())
+* hooks fire from the workers as soon as each part is parsed: hooks of the same part
+* keep their order and run on the same thread, but parts are delivered concurrently.
+*
+* Bodies up to a slice are decoded serially on the calling thread.
+*
+* Batches of bodies sharing a boundary are spread over the same workers, one body
+* per worker at a time (see decodeBatch()).
+*/
+class ParallelDecoder {
+
+    enum Hook { PartDataBegin, HeaderField, HeaderValue, HeadersComplete, PartData, PartDataEnd, BodyEnd };
+
+    // Parser hook recorded by a worker, to be delivered in document order
+    struct Event {
+        Hook hook;
+        bool stored; // data is in the task storage (copy of parser lookbehind), at this offset
+        const char *at;
+        size_t length;
+    };
+
+    // Parsing unit: a part, from the end of its delimiter up to the end of the next one
+    struct Task {
+        size_t begin;        // offset where parsing resumes (0 for the first part)
+        size_t end;          // offset after the next delimiter, 0 if it is the last task (parsed up to the end of the body)
+        size_t parsed;       // offset reached
+        bool stopped;        // a hook stopped the parsing
+        unsigned char state; // parser state reached
+        size_t index;
+        std::vector<Event> events;
+        std::string storage;
+        std::atomic<bool> done;
+    };
+
+    struct Recorder;
+    struct Stopper;
+    template <class Handler>
+    struct Forwarder;
+
+    template <class Hooks>
+    void parse(Task &task, size_t worker, Hooks &hooks);
+
+    template <class Handler>
+    bool replay(Task &task, Handler &handler);
+    void locateStop(Task &task, size_t hooks);
+
+    void run(const std::function<void(size_t)> &work);
+    void loop(size_t worker);
+    void arm(const std::string &boundary, const char *data, size_t length);
+    void scan();
+    void plan();
+    size_t conclude();
+
+    // Workers (the calling thread is worker 0):
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    const std::function<void(size_t)> *work_;
+    size_t generation_;
+    size_t pending_;
+    bool stop_;
+    std::vector<multipart_parser> parsers_;
+
+    // Current body:
+    const char *data_;
+    size_t length_;
+    std::vector<std::vector<size_t>> found_; // delimiter positions by slice
+    std::vector<size_t> delimiters_;
+    std::vector<std::unique_ptr<Task>> tasks_;
+    size_t count_;
+    std::atomic<size_t> next_;
+    std::atomic<bool> abort_;
+
+    size_t slice_size_;
+    bool ordered_;
+    unsigned char state_;
+    size_t index_;
+
+    std::vector<DecodeResult> batch_;
+
+    static thread_local size_t part_;
+
+public:
+
+    /**
+    * Default constructor
+    *
+    * @param threads Number of threads decoding, including the calling one (0: hardware concurrency)
+    */
+    ParallelDecoder(size_t threads = 0);
+    ~ParallelDecoder();
+
+    ParallelDecoder(const ParallelDecoder&) = delete;
+    ParallelDecoder& operator=(const ParallelDecoder&) = delete;
+
+    /**
+    * Slice of the body searched for delimiters by each worker (1 MiB by default)
+    *
+    * @param bytes Slice size
+    */
+    void setSliceSize(size_t bytes) {
+        slice_size_ = bytes ? bytes : 1;
+    }
+
+    /**
+    * Enables or disables delivery in document order (enabled by default)
+    *
+    * In order-agnostic mode, execute() calls the handler hooks concurrently from
+    * the workers (see part()). On malformed bodies, parts following the malformed
+    * one may have been delivered.
+    *
+    * @param ordered Document order mode
+    */
+    void setOrdered(bool ordered) {
+        ordered_ = ordered;
+    }
+
+    /**
+    * Decodes a whole body calling the handler hooks (see ParserHandler)
+    *
+    * Every hook fires as multipart_parser_execute() would fire it on the whole body.
+    *
+    * @param boundary Multipart boundary string
+    * @param data Body content
+    * @param length Body length
+    * @param handler Parser hooks
+    *
+    * @return number of bytes parsed, as multipart_parser_execute() (less than length on
+    * error), also when a hook stops the decoding.
+    */
+    template <class Handler>
+    size_t execute(const std::string &boundary, const char *data, size_t length, Handler &handler);
+
+    /**
+    * Decodes a whole body through a consumer, always in document order
+    *
+    * Equivalent to consumer.feed(data, length) on a consumer just constructed or reset.
+    *
+    * @param consumer Consumer
+    * @param data Body content
+    * @param length Body length
+    *
+    * @return false if the body is malformed
+    */
+    template <class Derived>
+    bool decode(BasicConsumer<Derived> &consumer, const char *data, size_t length);
+
+    /**
+    * Decodes a batch of bodies sharing the boundary
+    *
+    * Each worker decodes whole bodies with its own consumer, armed with the boundary
+    * once and rewound (see BasicConsumer::rewind()) for each body, so the cost per
+    * body is the parsing itself. Bodies are taken in order by the next worker free.
+    *
+    * @param boundary Multipart boundary string
+    * @param bodies Bodies content
+    * @param count Number of bodies
+    * @param consumers Consumer for each worker (see workers()): fewer consumers use fewer workers
+    * @param done Called on the worker once each body is decoded, with its consumer and body index
+    *
+    * @return result of each consumer (see BasicConsumer::result()) for each body, valid
+    * until next batch. Empty without consumers.
+    */
+    template <class T>
+    const std::vector<DecodeResult> &decodeBatch(const std::string &boundary, const std::string_view *bodies, size_t count,
+            const std::vector<T*> &consumers, const std::function<void(T &consumer, size_t body)> &done = nullptr);
+
+    /**
+    * @return number of threads decoding, including the calling one
+    */
+    size_t workers() const {
+        return parsers_.size();
+    }
+
+    /**
+    * @return true if the closing delimiter was reached by the last decoding
+    */
+    bool completed() const {
+        return (state_ == s_end);
+    }
+
+    /**
+    * @return index of the part whose hooks are running on the calling thread, in
+    * order-agnostic mode (the first part is 0)
+    */
+    static size_t part() {
+        return part_;
+    }
+};
+
+// Records the hooks of a part, stopping at its end
+struct ParallelDecoder::Recorder {
+    Task &task;
+    const char *body_begin;
+    const char *body_end;
+
+    int record(Hook hook, const char *at = nullptr, size_t length = 0) {
+        task.events.push_back(Event{hook, false, at, length});
+        return 0;
+    }
+
+    int onPartDataBegin() {
+        return record(PartDataBegin);
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return record(HeaderField, at, length);
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return record(HeaderValue, at, length);
+    }
+    int onHeadersComplete() {
+        return record(HeadersComplete);
+    }
+    int onPartData(const char *at, size_t length) {
+        if (at < body_begin || at >= body_end) { // parser lookbehind
+            task.events.push_back(Event{PartData, true, (const char*)task.storage.size(), length});
+            task.storage.append(at, length);
+            return 0;
+        }
+        return record(PartData, at, length);
+    }
+    int onPartDataEnd() {
+        record(PartDataEnd);
+        return 1;
+    }
+    int onBodyEnd() {
+        return record(BodyEnd);
+    }
+};
+
+// Parses a part again up to the hook which stopped its replay (as the Recorder
+// does, the end of the part ends the parsing), to find where the parser stops
+struct ParallelDecoder::Stopper {
+    size_t hooks; // before the one stopping
+
+    int hook() {
+        return (hooks-- == 0) ? 1 : 0;
+    }
+
+    int onPartDataBegin() {
+        return hook();
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return hook();
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return hook();
+    }
+    int onHeadersComplete() {
+        return hook();
+    }
+    int onPartData(const char *at, size_t length) {
+        return hook();
+    }
+    int onPartDataEnd() {
+        hook();
+        return 1;
+    }
+    int onBodyEnd() {
+        return hook();
+    }
+};
+
+// Calls the hooks of a part directly, stopping at its end
+template <class Handler>
+struct ParallelDecoder::Forwarder {
+    Task &task;
+    Handler &handler;
+
+    int check(int result) {
+        if (result != 0) task.stopped = true;
+        return result;
+    }
+
+    int onPartDataBegin() {
+        return check(handler.onPartDataBegin());
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return check(handler.onHeaderField(at, length));
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return check(handler.onHeaderValue(at, length));
+    }
+    int onHeadersComplete() {
+        int result = handler.onHeadersComplete();
+        return (result == MULTIPART_SKIP_PART) ? result : check(result);
+    }
+    int onPartData(const char *at, size_t length) {
+        return check(handler.onPartData(at, length));
+    }
+    int onPartDataEnd() {
+        check(handler.onPartDataEnd());
+        return 1;
+    }
+    int onBodyEnd() {
+        return check(handler.onBodyEnd());
+    }
+};
+
+template <class Hooks>
+void ParallelDecoder::parse(Task &task, size_t worker, Hooks &hooks)
+{
+    multipart_parser *p = &parsers_[worker];
+    p->state = task.begin ? s_part_data_almost_end : s_start;
+    p->index = 0;
+    p->skipping = 0;
+
+    task.parsed = task.begin + multipart_parser_execute(p, hooks, data_ + task.begin, length_ - task.begin);
+    task.state = p->state;
+    task.index = p->index;
+    task.done.store(true, std::memory_order_release);
+}
+
+template <class Handler>
+bool ParallelDecoder::replay(Task &task, Handler &handler)
+{
+    bool skipping = false;
+    for (const Event &event : task.events) {
+        int result = 0;
+        switch (event.hook) {
+        case PartDataBegin:
+            result = handler.onPartDataBegin();
+            break;
+        case HeaderField:
+            result = handler.onHeaderField(event.at, event.length);
+            break;
+        case HeaderValue:
+            result = handler.onHeaderValue(event.at, event.length);
+            break;
+        case HeadersComplete:
+            result = handler.onHeadersComplete();
+            if (result == MULTIPART_SKIP_PART) {
+                skipping = true;
+                result = 0;
+            }
+            break;
+        case PartData:
+            if (skipping) {
+                break;
+            }
+            result = handler.onPartData(event.stored ? task.storage.data() + (size_t)event.at : event.at, event.length);
+            break;
+        case PartDataEnd:
+            result = handler.onPartDataEnd();
+            break;
+        case BodyEnd:
+            result = handler.onBodyEnd();
+            break;
+        }
+        if (result != 0) {
+            task.stopped = true;
+            locateStop(task, &event - task.events.data());
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Handler>
+size_t ParallelDecoder::execute(const std::string &boundary, const char *data, size_t length, Handler &handler)
+{
+    arm(boundary, data, length);
+
+    if (ordered_ && (threads_.empty() || length <= slice_size_)) {
+        multipart_parser *p = &parsers_[0];
+        size_t parsed = multipart_parser_execute(p, handler, data, length);
+        state_ = p->state;
+        index_ = p->index;
+        return parsed;
+    }
+
+    scan();
+    plan();
+
+    if (ordered_) {
+        run([&](size_t worker) {
+            size_t k = 0; // next task to deliver (calling thread)
+            while (!abort_.load(std::memory_order_relaxed)) {
+                if (worker == 0) {
+                    while (k < count_ && tasks_[k]->done.load(std::memory_order_acquire)) {
+                        Task &task = *tasks_[k++];
+                        if (!replay(task, handler) || task.parsed != (task.end ? task.end : length_)) {
+                            k = count_;
+                        }
+                    }
+                    if (k == count_) {
+                        abort_.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+                size_t t = next_.fetch_add(1, std::memory_order_relaxed);
+                if (t >= count_) {
+                    if (worker != 0) break;
+                    std::this_thread::yield(); // waiting for parts being parsed by other workers
+                    continue;
+                }
+                Recorder recorder{*tasks_[t], data_, data_ + length_};
+                parse(*tasks_[t], worker, recorder);
+            }
+        });
+    }
+    else {
+        run([&](size_t worker) {
+            size_t t;
+            while (!abort_.load(std::memory_order_relaxed) && (t = next_.fetch_add(1, std::memory_order_relaxed)) < count_) {
+                Forwarder<Handler> forwarder{*tasks_[t], handler};
+                part_ = t;
+                parse(*tasks_[t], worker, forwarder);
+                if (tasks_[t]->stopped) abort_.store(true, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    return conclude();
+}
+
+template <class Derived>
+bool ParallelDecoder::decode(BasicConsumer<Derived> &consumer, const char *data, size_t length)
+{
+    if (consumer.failed_) {
+        return false;
+    }
+
+    multipart_parser *p = &consumer.parser_;
+    std::string boundary(p->multipart_boundary + 2, p->boundary_length - 2); // without "--" prefix
+
+    bool ordered = ordered_;
+    ordered_ = true;
+    consumer.metricsChunkBegin();
+    size_t allowed = consumer.allowance(length);
+    consumer.chunk_end_ = data + allowed;
+    size_t parsed = execute(boundary, data, allowed, consumer);
+    consumer.parsedChunk(length, allowed, parsed);
+    consumer.chunk_end_ = nullptr;
+    consumer.metricsChunkEnd(length, parsed);
+    ordered_ = ordered;
+
+    // Consumer parser continues from the state reached:
+    p->state = state_;
+    p->index = index_;
+
+    return !consumer.failed_;
+}
+
+template <class T>
+const std::vector<DecodeResult> &ParallelDecoder::decodeBatch(const std::string &boundary, const std::string_view *bodies, size_t count,
+        const std::vector<T*> &consumers, const std::function<void(T &consumer, size_t body)> &done)
+{
+    if (consumers.empty()) {
+        batch_.clear();
+        return batch_;
+    }
+    batch_.resize(count);
+    std::atomic<size_t> next(0);
+
+    std::function<void(size_t)> work = [&](size_t worker) {
+        if (worker >= consumers.size()) {
+            return;
+        }
+        T &consumer = *consumers[worker];
+        bool armed = consumer.reset(boundary);
+        for (size_t body; (body = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+            if (armed) {
+                consumer.rewind();
+                consumer.feed(bodies[body].data(), bodies[body].size());
+                consumer.finish();
+            }
+            batch_[body] = consumer.result();
+            if (done) {
+                done(consumer, body);
+            }
+        }
+    };
+
+    if (threads_.empty() || consumers.size() < 2 || count < 2) {
+        work(0);
+    }
+    else {
+        run(work);
+    }
+
+    return batch_;
+}
+
+}
+}
@@ -0,0 +1,539 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stdlib.h>
+
+#include <ert/multipart/Config.hpp> // ERT_MULTIPART_TRACING
+#include <ert/multipart/HeaderId.hpp>
+
+#if ERT_MULTIPART_TRACING > 0
+#include <ert/tracing/Logger.hpp>
+#define ERT_MULTIPART_TRACE_ERROR(text) LOGDEBUG(ert::tracing::Logger::debug(text,  ERT_FILE_LOCATION))
+#else
+#define ERT_MULTIPART_TRACE_ERROR(text)
+#endif
+
+#if ERT_MULTIPART_TRACING > 1
+#define ERT_MULTIPART_TRACE_BYTE(text) LOGDEBUG(ert::tracing::Logger::debug(text,  ERT_FILE_LOCATION))
+#else
+#define ERT_MULTIPART_TRACE_BYTE(text)
+#endif
+
+#if ERT_MULTIPART_TRACING == 1
+#define ERT_MULTIPART_TRACE_TRANSITION()                               \
+do {                                                                   \
+  if (state != traced) {                                               \
+    traced = state;                                                    \
+    LOGDEBUG(ert::tracing::Logger::debug(multipart_state_name(traced),  ERT_FILE_LOCATION)); \
+  }                                                                    \
+} while (0)
+#else
+#define ERT_MULTIPART_TRACE_TRANSITION()
+#endif
+
+#define ERT_MULTIPART_RETURN(position)                                 \
+do {                                                                   \
+  p->state = state;                                                    \
+  p->index = index;                                                    \
+  p->skipping = skipping;                                              \
+  return position;                                                     \
+} while (0)
+
+#define ERT_MULTIPART_NOTIFY(HOOK)                                     \
+do {                                                                   \
+  if (handler.HOOK() != 0) {                                           \
+    ERT_MULTIPART_RETURN(i);                                           \
+  }                                                                    \
+} while (0)
+
+#define ERT_MULTIPART_EMIT(HOOK, ptr, len)                             \
+do {                                                                   \
+  if (handler.HOOK(ptr, len) != 0) {                                   \
+    ERT_MULTIPART_RETURN(i);                                           \
+  }                                                                    \
+} while (0)
+
+
+namespace ert
+{
+namespace multipart
+{
+
+typedef struct multipart_parser multipart_parser;
+typedef struct multipart_parser_settings multipart_parser_settings;
+typedef struct multipart_parser_state multipart_parser_state;
+
+typedef int (*multipart_data_cb) (multipart_parser*, const char *at, size_t length);
+typedef int (*multipart_notify_cb) (multipart_parser*);
+
+struct multipart_parser_settings {
+    multipart_data_cb on_header_field;
+    multipart_data_cb on_header_value;
+    multipart_data_cb on_part_data;
+
+    multipart_notify_cb on_part_data_begin;
+    multipart_notify_cb on_headers_complete;
+    multipart_notify_cb on_part_data_end;
+    multipart_notify_cb on_body_end;
+};
+
+/**
+* Strategy used to locate the delimiter inside part data
+*/
+enum multipart_matcher {
+    MULTIPART_MATCHER_BYTE,  // byte-at-a-time state machine walk
+    MULTIPART_MATCHER_SIMD,  // bulk scan for delimiter candidates (AVX2/SSE2, scalar fallback), default
+    MULTIPART_MATCHER_HORSPOOL // Boyer-Moore-Horspool search of the whole delimiter (suits long boundaries)
+};
+
+multipart_parser* multipart_parser_init
+(const char *boundary, const multipart_parser_settings* settings);
+
+/**
+* Initializes a parser provided by the caller (i.e. embedded by value), without
+* allocation for boundaries within RFC 2046 limit
+*
+* @return 0 on success, -1 on allocation failure
+*/
+int multipart_parser_construct
+(multipart_parser* p, const char *boundary, const multipart_parser_settings* settings);
+
+/**
+* Releases the resources of a parser initialized with multipart_parser_construct()
+*/
+void multipart_parser_destroy(multipart_parser* p);
+
+/**
+* Rearms the parser for a new body, without allocation for boundaries within
+* RFC 2046 limit
+*
+* @return 0 on success, -1 on allocation failure
+*/
+int multipart_parser_reset(multipart_parser* p, const char *boundary);
+
+/**
+* Rearms the parser for a new body with the same boundary, keeping the delimiter
+* tables (i.e. to decode a batch of bodies)
+*/
+void multipart_parser_rewind(multipart_parser* p);
+
+/**
+* @return non-zero once the closing delimiter has been parsed
+*/
+int multipart_parser_completed(multipart_parser* p);
+
+void multipart_parser_set_matcher(multipart_parser* p, multipart_matcher matcher);
+
+/**
+* Instruction set selected at runtime for MULTIPART_MATCHER_SIMD: "avx2", "sse2" or "scalar"
+*/
+const char *multipart_parser_scan_isa();
+
+/**
+* Parser tracing compiled into the library (ERT_MULTIPART_Tracing cmake option): "OFF", "STATE" or "BYTE"
+*/
+const char *multipart_parser_tracing();
+
+void multipart_parser_free(multipart_parser* p);
+
+size_t multipart_parser_execute(multipart_parser* p, const char *buf, size_t len);
+
+void multipart_parser_set_data(multipart_parser* p, void* data);
+void *multipart_parser_get_data(multipart_parser* p);
+
+#define MULTIPART_BOUNDARY_MAX 70 // RFC 2046
+
+// on_headers_complete (onHeadersComplete) result to skip the part data: the parser
+// only searches for the next delimiter, without on_part_data calls
+#define MULTIPART_SKIP_PART 2
+
+struct multipart_parser {
+    void * data;
+
+    size_t index;
+    size_t boundary_length;
+    size_t capacity; // maximum boundary_length for current storage
+
+    unsigned char state;
+    unsigned char matcher;
+    unsigned char skipping; // current part data is skipped (MULTIPART_SKIP_PART)
+
+    const multipart_parser_settings* settings;
+
+    unsigned char skip[256]; // Horspool shifts for the delimiter ("\r\n" + multipart_boundary)
+
+    char* multipart_boundary;
+    char* lookbehind;
+
+    char* heap; // storage for boundaries over the limit
+    char buffer[2*(MULTIPART_BOUNDARY_MAX + 2) + 9];
+};
+
+enum state {
+    s_uninitialized = 1,
+    s_start,
+    s_start_boundary,
+    s_header_field_start,
+    s_header_field,
+    s_headers_almost_done,
+    s_header_value_start,
+    s_header_value,
+    s_header_value_almost_done,
+    s_part_data_start,
+    s_part_data,
+    s_part_data_almost_boundary,
+    s_part_data_boundary,
+    s_part_data_almost_end,
+    s_part_data_end,
+    s_part_data_final_hyphen,
+    s_end
+};
+
+const char *multipart_state_name(unsigned char state);
+
+/**
+* Offset of the first position in part data which may start the delimiter
+* (completely, or truncated at the end of the buffer), using the parser matcher
+*
+* @return offset, or len if there is none
+*/
+size_t multipart_parser_scan(multipart_parser* p, const char *buf, size_t len);
+
+/**
+* Delimiter of the parser boundary, given at runtime (see multipart_parser_execute_with())
+*
+* Boundary policies tell the boundary, prefixed by "--" (i.e. "--boundary"), its
+* length, and scan part data for the next delimiter candidate (as multipart_parser_scan()).
+*/
+struct multipart_runtime_boundary {
+    static const char *boundary(const multipart_parser* p) {
+        return p->multipart_boundary;
+    }
+    static size_t length(const multipart_parser* p) {
+        return p->boundary_length;
+    }
+    static size_t scan(multipart_parser* p, const char *buf, size_t len) {
+        return multipart_parser_scan(p, buf, len);
+    }
+};
+
+/**
+* Default hooks for multipart_parser_execute() handlers
+*
+* Handlers are called directly (statically dispatched), so they can be inlined
+* into the state machine. Hooks mirror multipart_parser_settings callbacks:
+* a non-zero return value stops the parsing. When onPartDataEnd() stops it, the
+* parser can be resumed at the returned position (the byte after the delimiter).
+* onHeadersComplete() may return MULTIPART_SKIP_PART to skip the part data: then,
+* onPartData() is not called until onPartDataEnd().
+*/
+struct ParserHandler {
+    int onPartDataBegin() {
+        return 0;
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return 0;
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return 0;
+    }
+    int onHeadersComplete() {
+        return 0;
+    }
+    int onPartData(const char *at, size_t length) {
+        return 0;
+    }
+    int onPartDataEnd() {
+        return 0;
+    }
+    int onBodyEnd() {
+        return 0;
+    }
+};
+
+/**
+* Parses a body chunk calling the handler hooks (see ParserHandler), with the
+* delimiter given by a boundary policy (see multipart_runtime_boundary)
+*
+* @return number of bytes parsed (less than len on error or when a hook stops the parsing)
+*/
+template <class Boundary, class Handler>
+size_t multipart_parser_execute_with(multipart_parser* p, Handler& handler, const char *buf, size_t len) {
+    const char CR = 13;
+    const char LF = 10;
+
+    // Working copies, stored back on return:
+    unsigned char state = p->state;
+    size_t index = p->index;
+    unsigned char skipping = p->skipping;
+    size_t i = 0;
+    size_t mark = 0;
+    char c;
+    int is_last = 0;
+#if ERT_MULTIPART_TRACING == 1
+    unsigned char traced = 0;
+#endif
+
+    while(i < len) {
+        c = buf[i];
+        is_last = (i == (len - 1));
+        ERT_MULTIPART_TRACE_TRANSITION();
+        switch (state) {
+        case s_start:
+            ERT_MULTIPART_TRACE_BYTE("s_start");
+            index = 0;
+            state = s_start_boundary;
+
+        // fallthrough
+        case s_start_boundary:
+            ERT_MULTIPART_TRACE_BYTE("s_start_boundary");
+            if (index == Boundary::length(p)) {
+                if (c != CR) {
+                    ERT_MULTIPART_RETURN(i);
+                }
+                index++;
+                break;
+            } else if (index == (Boundary::length(p) + 1)) {
+                if (c != LF) {
+                    ERT_MULTIPART_RETURN(i);
+                }
+                index = 0;
+                ERT_MULTIPART_NOTIFY(onPartDataBegin);
+                state = s_header_field_start;
+                break;
+            }
+            if (c != Boundary::boundary(p)[index]) {
+                ERT_MULTIPART_RETURN(i);
+            }
+            index++;
+            break;
+
+        case s_header_field_start:
+            ERT_MULTIPART_TRACE_BYTE("s_header_field_start");
+            mark = i;
+            state = s_header_field;
+
+        // fallthrough
+        case s_header_field:
+            ERT_MULTIPART_TRACE_BYTE("s_header_field");
+            if (c == CR) {
+                state = s_headers_almost_done;
+                break;
+            }
+
+            if (c == ':') {
+                ERT_MULTIPART_EMIT(onHeaderField, buf + mark, i - mark);
+                state = s_header_value_start;
+                break;
+            }
+
+            if (!HeaderChars.lower[(unsigned char)c]) {
+                ERT_MULTIPART_TRACE_ERROR("invalid character in header name");
+                ERT_MULTIPART_RETURN(i);
+            }
+            if (is_last)
+                ERT_MULTIPART_EMIT(onHeaderField, buf + mark, (i - mark) + 1);
+            break;
+
+        case s_headers_almost_done:
+            ERT_MULTIPART_TRACE_BYTE("s_headers_almost_done");
+            if (c != LF) {
+                ERT_MULTIPART_RETURN(i);
+            }
+
+            state = s_part_data_start;
+            break;
+
+        case s_header_value_start:
+            ERT_MULTIPART_TRACE_BYTE("s_header_value_start");
+            if (c == ' ') {
+                break;
+            }
+
+            mark = i;
+            state = s_header_value;
+
+        // fallthrough
+        case s_header_value:
+            ERT_MULTIPART_TRACE_BYTE("s_header_value");
+            if (c == CR) {
+                ERT_MULTIPART_EMIT(onHeaderValue, buf + mark, i - mark);
+                state = s_header_value_almost_done;
+                break;
+            }
+            if (is_last)
+                ERT_MULTIPART_EMIT(onHeaderValue, buf + mark, (i - mark) + 1);
+            break;
+
+        case s_header_value_almost_done:
+            ERT_MULTIPART_TRACE_BYTE("s_header_value_almost_done");
+            if (c != LF) {
+                ERT_MULTIPART_RETURN(i);
+            }
+            state = s_header_field_start;
+            break;
+
+        case s_part_data_start:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data_start");
+            {
+                int result = handler.onHeadersComplete();
+                if (result == MULTIPART_SKIP_PART) {
+                    skipping = 1;
+                }
+                else if (result != 0) {
+                    ERT_MULTIPART_RETURN(i);
+                }
+            }
+            mark = i;
+            state = s_part_data;
+
+        // fallthrough
+        case s_part_data:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data");
+            if (p->matcher != MULTIPART_MATCHER_BYTE) {
+                i += Boundary::scan(p, buf + i, len - i);
+                if (i == len) {
+                    if (!skipping) ERT_MULTIPART_EMIT(onPartData, buf + mark, i - mark);
+                    ERT_MULTIPART_RETURN(len);
+                }
+                c = buf[i];
+            }
+            if (c == CR) {
+                if (!skipping) ERT_MULTIPART_EMIT(onPartData, buf + mark, i - mark);
+                mark = i;
+                state = s_part_data_almost_boundary;
+                p->lookbehind[0] = CR;
+                break;
+            }
+            if (is_last && !skipping)
+                ERT_MULTIPART_EMIT(onPartData, buf + mark, (i - mark) + 1);
+            break;
+
+        case s_part_data_almost_boundary:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data_almost_boundary");
+            if (c == LF) {
+                state = s_part_data_boundary;
+                p->lookbehind[1] = LF;
+                index = 0;
+                break;
+            }
+            if (!skipping) ERT_MULTIPART_EMIT(onPartData, p->lookbehind, 1);
+            state = s_part_data;
+            mark = i --;
+            break;
+
+        case s_part_data_boundary:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data_boundary");
+            if (Boundary::boundary(p)[index] != c) {
+                if (!skipping) ERT_MULTIPART_EMIT(onPartData, p->lookbehind, 2 + index);
+                state = s_part_data;
+                mark = i --;
+                break;
+            }
+            p->lookbehind[2 + index] = c;
+            if ((++ index) == Boundary::length(p)) {
+                state = s_part_data_almost_end;
+                skipping = 0;
+                if (handler.onPartDataEnd() != 0) { // resumable at next byte
+                    ERT_MULTIPART_RETURN(i + 1);
+                }
+            }
+            break;
+
+        case s_part_data_almost_end:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data_almost_end");
+            if (c == '-') {
+                state = s_part_data_final_hyphen;
+                break;
+            }
+            if (c == CR) {
+                state = s_part_data_end;
+                break;
+            }
+            ERT_MULTIPART_RETURN(i);
+
+        case s_part_data_final_hyphen:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data_final_hyphen");
+            if (c == '-') {
+                ERT_MULTIPART_NOTIFY(onBodyEnd);
+                state = s_end;
+                break;
+            }
+            ERT_MULTIPART_RETURN(i);
+
+        case s_part_data_end:
+            ERT_MULTIPART_TRACE_BYTE("s_part_data_end");
+            if (c == LF) {
+                state = s_header_field_start;
+                ERT_MULTIPART_NOTIFY(onPartDataBegin);
+                break;
+            }
+            ERT_MULTIPART_RETURN(i);
+
+        case s_end:
+            ERT_MULTIPART_TRACE_BYTE(ert::tracing::Logger::asString("s_end: %02X", (int)c));
+            break;
+
+        default:
+            ERT_MULTIPART_TRACE_ERROR("Multipart parser unrecoverable error");
+            ERT_MULTIPART_RETURN(0);
+        }
+        ++ i;
+    }
+
+    ERT_MULTIPART_RETURN(len);
+}
+
+/**
+* Parses a body chunk calling the handler hooks (see ParserHandler)
+*
+* @return number of bytes parsed (less than len on error or when a hook stops the parsing)
+*/
+template <class Handler>
+size_t multipart_parser_execute(multipart_parser* p, Handler& handler, const char *buf, size_t len) {
+    return multipart_parser_execute_with<multipart_runtime_boundary>(p, handler, buf, len);
+}
+
+}
+}
+
+#undef ERT_MULTIPART_RETURN
+#undef ERT_MULTIPART_NOTIFY
+#undef ERT_MULTIPART_EMIT
+#undef ERT_MULTIPART_TRACE_ERROR
+#undef ERT_MULTIPART_TRACE_BYTE
+#undef ERT_MULTIPART_TRACE_TRANSITION
@@ -0,0 +1,178 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Range of the indexed buffer
+*/
+struct Span {
+    size_t offset = 0;
+    size_t length = 0;
+};
+
+/**
+* Part location within the indexed buffer
+*/
+struct IndexedPart {
+    Span body;
+    Span contentType;     // Content-Type header value (empty if missing)
+    Span contentId;       // Content-ID header value, without angle brackets
+    Span contentLocation; // Content-Location header value
+};
+
+/**
+* Random access to the parts of a contiguous multipart body, by position,
+* Content-ID and Content-Location (i.e. multipart/related)
+*
+* The index is built in one pass of the parser and only records offsets and
+* lengths into the body, which is not copied:
+*
+* @code
+* ert::multipart::PartIndex index;
+* if (index.build(body, boundary)) {
+*     const ert::multipart::IndexedPart *root = index.root(contentType); // "multipart/related; start=..."
+*     const ert::multipart::IndexedPart *n1 = index.findById("n1msg");
+*     if (n1) process(index.view(n1->body));
+* }
+* @endcode
+*
+* Lookups take constant time, and keep working when the body is moved (identifiers
+* and locations are copied). The body must outlive the index, or be given again to
+* view() when it has been moved.
+*/
+class PartIndex {
+
+    struct Handler;
+
+    std::string_view buffer_;
+    std::vector<IndexedPart> parts_;
+    std::unordered_map<std::string, size_t> by_id_;       // owned keys: valid when the body is moved
+    std::unordered_map<std::string, size_t> by_location_;
+    bool failed_;
+
+public:
+
+    PartIndex() : failed_(false) {}
+
+    /**
+    * Indexes a body (previous index is cleared)
+    *
+    * @param body Body content (not copied)
+    * @param boundary Multipart boundary string
+    *
+    * @return false if the body is malformed (parts before the malformed one are indexed)
+    */
+    bool build(std::string_view body, const std::string& boundary);
+
+    /**
+    * @return number of parts indexed
+    */
+    size_t size() const {
+        return parts_.size();
+    }
+
+    /**
+    * @return true if the indexed body is malformed
+    */
+    bool failed() const {
+        return failed_;
+    }
+
+    /**
+    * Part by position (the first part is 0)
+    *
+    * @return part, nullptr if out of range
+    */
+    const IndexedPart *at(size_t position) const {
+        return (position < parts_.size()) ? &parts_[position] : nullptr;
+    }
+
+    /**
+    * Part by Content-ID
+    *
+    * @param contentId Identifier, with or without angle brackets, or as a "cid:" URL (RFC 2392)
+    *
+    * @return first part with that identifier, nullptr if missing
+    */
+    const IndexedPart *findById(std::string_view contentId) const;
+
+    /**
+    * Part by Content-Location
+    *
+    * @param location Location, as in the header
+    *
+    * @return first part with that location, nullptr if missing
+    */
+    const IndexedPart *findByLocation(std::string_view location) const;
+
+    /**
+    * Root part of a multipart/related body (RFC 2387)
+    *
+    * @param contentType Body Content-Type header value: its 'start' parameter refers to
+    * the root Content-ID, otherwise the root is the first part
+    *
+    * @return root part, nullptr if missing
+    */
+    const IndexedPart *root(std::string_view contentType) const;
+
+    /**
+    * @return content of a span in the indexed body
+    */
+    std::string_view view(const Span &span) const {
+        return buffer_.substr(span.offset, span.length);
+    }
+
+    /**
+    * @return content of a span in the body given (i.e. the indexed one, moved)
+    */
+    static std::string_view view(std::string_view body, const Span &span) {
+        return body.substr(span.offset, span.length);
+    }
+};
+
+}
+}
@@ -0,0 +1,162 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/uio.h>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Multipart encoder
+*
+* Parts are given as headers and body views, which must remain valid until the
+* encoding is done (nothing is copied when parts are added):
+*
+* @code
+* ert::multipart::Producer producer;
+* producer.addPart({{"Content-Type", "application/json"}}, json);
+* producer.addPart({{"Content-Type", "application/octet-stream"}}, binary);
+* std::string contentType = "multipart/related; boundary=" + producer.boundary();
+* std::string body = producer.encode();  // or producer.iovecs() for writev()
+* @endcode
+*/
+class Producer {
+
+public:
+    using Header = std::pair<std::string_view, std::string_view>; // name, value
+
+private:
+
+    struct PartEntry {
+        size_t firstHeader;
+        size_t headers;
+        std::string_view body;
+    };
+
+    bool collides(const std::string &boundary) const;
+    const std::string &ensureBoundary();
+    void appendPart(size_t firstHeader, std::string_view body);
+
+    std::string boundary_; // empty while a generated boundary is due (none yet, or a part collided)
+    bool generated_;
+
+    std::vector<Header> headers_;
+    std::vector<PartEntry> parts_;
+
+    std::string framing_; // delimiters and headers, referred by iovecs_
+    std::vector<struct iovec> iovecs_;
+    std::vector<size_t> ends_; // framing end offset before each part body (iovecs())
+
+public:
+
+    /**
+    * Constructor with random boundary, generated when first needed and
+    * checked not to collide with the parts content
+    */
+    Producer();
+
+    /**
+    * Constructor with fixed boundary
+    *
+    * @param boundary Multipart boundary string
+    */
+    Producer(const std::string& boundary);
+
+    /**
+    * Adds a part
+    *
+    * @param headers Part headers (name, value)
+    * @param body Part body
+    */
+    void addPart(std::initializer_list<Header> headers, std::string_view body);
+    void addPart(const std::vector<Header> &headers, std::string_view body);
+
+    /**
+    * Removes the parts, keeping the allocated resources. A random boundary
+    * is generated again.
+    */
+    void clear();
+
+    /**
+    * Multipart boundary (i.e. for the Content-Type header). A random boundary
+    * is generated once parts are added, and replaced if a later part collides.
+    */
+    const std::string &boundary();
+
+    /**
+    * @return exact size of the encoded body
+    */
+    size_t size();
+
+    /**
+    * Encodes the body into a string allocated once with the exact size
+    */
+    std::string encode();
+
+    /**
+    * Encodes the body into the output string, reusing its capacity
+    *
+    * @param output Encoded body
+    */
+    void encode(std::string &output);
+
+    /**
+    * Encodes the body as scatter-gather buffers (for writev() or a nghttp2 data
+    * provider): part bodies are referred, not copied. Buffers are valid until
+    * the next call to a non-const method.
+    */
+    const std::vector<struct iovec> &iovecs();
+
+    /**
+    * Random boundary
+    *
+    * @param length Boundary length (RFC 2046 limit is 70)
+    */
+    static std::string randomBoundary(size_t length = 32);
+};
+
+}
+}
@@ -0,0 +1,293 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include <ert/multipart/Producer.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Editor of an existing multipart body, which re-encodes it without copying
+* what is left untouched
+*
+* The body is indexed in one pass of the parser. Parts may then be replaced,
+* dropped or inserted, and their headers rewritten. Encoding refers to the
+* original buffer for every unmodified byte range (consecutive untouched parts
+* are a single buffer), and only materializes delimiters and headers of the
+* changed parts:
+*
+* @code
+* ert::multipart::Rewriter rewriter;
+* if (rewriter.load(body, boundary)) {
+*     rewriter.dropPart(0);
+*     rewriter.setHeader(1, "Content-Type", "application/json");
+*     rewriter.replaceBody(2, json);
+*     writev(fd, rewriter.iovecs().data(), rewriter.iovecs().size());
+* }
+* @endcode
+*
+* Parts are addressed by their position in the original body, whatever the edits
+* made before. The original body and every view given (headers, bodies) must
+* remain valid until the encoding is done. The boundary is kept, so new bodies
+* must not contain it.
+*/
+class Rewriter {
+
+public:
+    using Header = Producer::Header; // name, value
+
+private:
+
+    struct Handler;
+
+    // Header of a part: original line (name and value refer to it), or edited
+    struct HeaderEntry {
+        std::string_view name;
+        std::string_view value;
+        size_t line;   // original line offset (npos: edited, encoded from name and value)
+        size_t length; // original line length, including CRLF
+    };
+
+    // Original part, and its edits:
+    struct PartEntry {
+        size_t begin;       // delimiter line
+        size_t bodyBegin;
+        size_t bodyEnd;     // followed by CRLF
+        size_t firstHeader; // into headers_
+        size_t headers;
+        size_t originalHeader; // original ones (see revert())
+        size_t originalHeaders;
+        bool dropped;
+        bool bodyReplaced;
+        bool headersEdited; // headers moved to an edited list (see editHeaders())
+        std::string_view body;
+    };
+
+    // Part inserted before an original one:
+    struct Insertion {
+        size_t position;
+        size_t firstHeader;
+        size_t headers;
+        std::string_view body;
+    };
+
+    // Output range: original body, framing_, or a view given
+    struct Piece {
+        enum Source : unsigned char { Original, Framing, External } source;
+        size_t offset; // Original and Framing
+        const char *data; // External
+        size_t length;
+    };
+
+    size_t indexHeaders(PartEntry &part, size_t line);
+    size_t editHeaders(size_t position);
+    void addHeaders(std::initializer_list<Header> headers, size_t &first, size_t &count);
+    void addHeaders(const std::vector<Header> &headers, size_t &first, size_t &count);
+    void emit(Piece::Source source, size_t offset, const char *data, size_t length);
+    void emitFraming(std::string_view text);
+    void emitHeaders(size_t first, size_t count);
+    void emitInsertion(const Insertion &insertion);
+    void build();
+
+    std::string_view buffer_;
+    std::string boundary_;
+    bool failed_;
+    size_t tail_; // closing delimiter (and epilogue)
+
+    std::vector<PartEntry> parts_;
+    std::vector<HeaderEntry> headers_; // original ones first, then edited lists
+    size_t original_headers_;
+    std::vector<Insertion> insertions_;
+
+    std::string framing_; // materialized delimiters and headers, referred by iovecs_
+    std::vector<Piece> pieces_;
+    std::vector<struct iovec> iovecs_;
+
+public:
+
+    Rewriter() : failed_(true), tail_(0), original_headers_(0) {}
+
+    /**
+    * Indexes a body to be edited (previous body and edits are cleared)
+    *
+    * @param body Body content (not copied)
+    * @param boundary Multipart boundary string
+    *
+    * @return false if the body is malformed or incomplete (then, it can not be
+    * edited, and it is encoded as it is)
+    */
+    bool load(std::string_view body, const std::string& boundary);
+
+    /**
+    * @return true if the loaded body is malformed
+    */
+    bool failed() const {
+        return failed_;
+    }
+
+    /**
+    * @return number of parts in the original body
+    */
+    size_t parts() const {
+        return parts_.size();
+    }
+
+    /**
+    * Original part body
+    *
+    * @param position Part position (the first part is 0)
+    *
+    * @return body view, empty if out of range
+    */
+    std::string_view body(size_t position) const;
+
+    /**
+    * Original part header value by name (case insensitive)
+    *
+    * @param position Part position
+    * @param name Header name (i.e. content-type)
+    *
+    * @return header value, empty if missing
+    */
+    std::string_view header(size_t position, std::string_view name) const;
+
+    /**
+    * Replaces a part, headers and body
+    *
+    * @param position Part position
+    * @param headers New part headers (name, value)
+    * @param body New part body
+    *
+    * @return false if the position is out of range
+    */
+    bool replacePart(size_t position, std::initializer_list<Header> headers, std::string_view body);
+    bool replacePart(size_t position, const std::vector<Header> &headers, std::string_view body);
+
+    /**
+    * Replaces the body of a part, keeping its headers
+    *
+    * @param position Part position
+    * @param body New part body
+    *
+    * @return false if the position is out of range
+    */
+    bool replaceBody(size_t position, std::string_view body);
+
+    /**
+    * Removes a part
+    *
+    * @param position Part position
+    *
+    * @return false if the position is out of range
+    */
+    bool dropPart(size_t position);
+
+    /**
+    * Sets the value of a part header (case insensitive name), which is added if missing
+    *
+    * @param position Part position
+    * @param name Header name
+    * @param value New header value
+    *
+    * @return false if the position is out of range
+    */
+    bool setHeader(size_t position, std::string_view name, std::string_view value);
+
+    /**
+    * Removes a part header (every occurrence, case insensitive name)
+    *
+    * @param position Part position
+    * @param name Header name
+    *
+    * @return false if the position is out of range
+    */
+    bool removeHeader(size_t position, std::string_view name);
+
+    /**
+    * Inserts a new part before an original one
+    *
+    * @param position Original part position (parts() to add it at the end)
+    * @param headers Part headers (name, value)
+    * @param body Part body
+    *
+    * @return false if the position is out of range
+    */
+    bool insertPart(size_t position, std::initializer_list<Header> headers, std::string_view body);
+    bool insertPart(size_t position, const std::vector<Header> &headers, std::string_view body);
+
+    /**
+    * Discards the edits, keeping the loaded body
+    */
+    void revert();
+
+    /**
+    * @return exact size of the encoded body
+    */
+    size_t size();
+
+    /**
+    * Encodes the edited body into a string allocated once with the exact size
+    */
+    std::string encode();
+
+    /**
+    * Encodes the edited body into the output string, reusing its capacity
+    *
+    * @param output Encoded body
+    */
+    void encode(std::string &output);
+
+    /**
+    * Encodes the edited body as scatter-gather buffers (for writev() or a nghttp2
+    * data provider): untouched ranges refer to the original body and new bodies
+    * to the views given. Buffers are valid until the next call to a non-const method.
+    */
+    const std::vector<struct iovec> &iovecs();
+};
+
+}
+}
@@ -0,0 +1,201 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <ert/multipart/Consumer.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Part data stored by SpillConsumer: in memory, or in a temporary file once it
+* exceeds the spill threshold
+*/
+class SpilledPart {
+
+    friend class SpillConsumer;
+
+    std::string memory_; // data (in memory), or data pending to be written (spilled)
+    std::string path_;
+    int fd_;
+    size_t size_;
+    void *map_;
+    bool keep_;
+    bool failed_;
+
+    void release();
+
+public:
+
+    SpilledPart();
+    ~SpilledPart();
+
+    SpilledPart(const SpilledPart&) = delete;
+    SpilledPart& operator=(const SpilledPart&) = delete;
+
+    /**
+    * @return part data size
+    */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+    * @return true if the data is stored in a file (see path())
+    */
+    bool spilled() const {
+        return (fd_ >= 0);
+    }
+
+    /**
+    * @return temporary file path (empty for parts kept in memory)
+    */
+    const std::string &path() const {
+        return path_;
+    }
+
+    /**
+    * @return true if the temporary file could not be created or written: data is incomplete
+    */
+    bool failed() const {
+        return failed_;
+    }
+
+    /**
+    * Part data
+    *
+    * Data in memory, or a read-only memory map of the temporary file (mapped on
+    * first call). The view is only valid during the callback.
+    *
+    * @return part data (empty if the file can not be mapped)
+    */
+    std::string_view view();
+
+    /**
+    * Keeps the temporary file after the callback (by default, it is removed):
+    * the file at path() is then owned by the application
+    */
+    void keep() {
+        keep_ = true;
+    }
+};
+
+/**
+* Multipart decoder storing large parts in temporary files
+*
+* Data of each part is accumulated in memory up to a threshold. Beyond it, the
+* part is spilled to a temporary file through large buffered writes, so memory
+* stays bounded whatever the size of the parts. Complete parts are delivered
+* through receiveSpilledPart():
+*
+* @code
+* class Uploads : public ert::multipart::SpillConsumer {
+* public:
+*     Uploads(const std::string &boundary) : SpillConsumer(boundary) {;}
+*     void receiveSpilledPart(ert::multipart::SpilledPart &part) override {
+*         if (part.spilled()) { part.keep(); store(part.path()); }
+*         else process(part.view());
+*     }
+* };
+* @endcode
+*
+* Coalesced parts mode must not be enabled: part data is collected here.
+*/
+class SpillConsumer : public Consumer {
+
+    SpilledPart part_;
+    size_t threshold_;
+    std::string directory_;
+
+    bool spill();
+    void write(const char *data, size_t length);
+
+public:
+
+    /**
+    * Size of file writes (part data is buffered up to it)
+    */
+    static constexpr size_t WriteSize = 1 << 20;
+
+    /**
+    * Default constructor
+    *
+    * @param boundary Multipart boundary string
+    */
+    SpillConsumer(const std::string& boundary);
+    virtual ~SpillConsumer();
+
+    /**
+    * Sets the part size beyond which data is spilled to a file (1 MiB by default)
+    *
+    * @param bytes Maximum part size kept in memory (0: every part with data is spilled)
+    */
+    void setSpillThreshold(size_t bytes) {
+        threshold_ = bytes;
+    }
+
+    /**
+    * Sets the directory for temporary files (TMPDIR, or /tmp, by default)
+    *
+    * @param directory Existing directory path
+    */
+    void setSpillDirectory(const std::string& directory) {
+        directory_ = directory;
+    }
+
+    /**
+    * Callback for complete part (default does nothing)
+    *
+    * Data and file are released when the call returns, unless the file is kept
+    * (see SpilledPart::keep()).
+    *
+    * @param part Part data
+    */
+    virtual void receiveSpilledPart(SpilledPart &part) {}
+
+    void receiveDataView(std::string_view data) override final;
+    void receivePartEnd() override final;
+    void receiveRearm() override final; // discards the part in progress
+};
+
+}
+}
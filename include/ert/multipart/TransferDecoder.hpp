@@ -0,0 +1,130 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string_view>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+/**
+* Content-Transfer-Encoding of a part (RFC 2045)
+*/
+enum class TransferEncoding : unsigned char {
+    Identity, // 7bit, 8bit, binary or missing
+    Base64,
+    QuotedPrintable
+};
+
+/**
+* Transfer encoding from a Content-Transfer-Encoding header value (case insensitive)
+*/
+TransferEncoding transferEncoding(std::string_view value);
+
+/**
+* Incremental Content-Transfer-Encoding decoder
+*
+* Data may be given in fragments split at any byte: encoded quanta (base64) and
+* escape sequences (quoted-printable) spanning fragments are completed with the
+* next ones. Base64 is decoded by blocks of 32 characters with AVX2 when the CPU
+* supports it. As RFC 2045 recommends, characters outside the base64 alphabet
+* (i.e. line breaks) are ignored, and malformed quoted-printable escapes are
+* delivered as they are.
+*/
+class TransferDecoder {
+
+    TransferEncoding encoding_;
+    uint32_t bits_;         // base64 sextets pending
+    unsigned char count_;   // number of them (quantum split across fragments)
+    bool padded_;           // base64 padding reached: data is over
+    char escape_[2];        // quoted-printable escape pending ("=" and next character)
+    unsigned char escape_length_;
+
+public:
+
+    TransferDecoder() {
+        reset(TransferEncoding::Identity);
+    }
+
+    /**
+    * Rearms the decoder for a new part
+    *
+    * @param encoding Part transfer encoding
+    */
+    void reset(TransferEncoding encoding);
+
+    /**
+    * @return output size needed to decode a fragment (see decode())
+    */
+    static size_t bound(size_t length) {
+        return length + 32;
+    }
+
+    /**
+    * Decodes next fragment
+    *
+    * @param data Encoded fragment
+    * @param length Fragment length
+    * @param output Decoded data storage, of bound(length) bytes at least
+    *
+    * @return number of decoded bytes
+    */
+    size_t decode(const char *data, size_t length, char *output);
+
+    /**
+    * Completes the part, delivering the data still pending (quoted-printable
+    * escape truncated). An incomplete base64 quantum is dropped.
+    *
+    * @param output Decoded data storage, of bound(0) bytes at least
+    *
+    * @return number of decoded bytes
+    */
+    size_t finish(char *output);
+
+    /**
+    * Instruction set selected at runtime for base64: "avx2" or "scalar"
+    */
+    static const char *isa();
+};
+
+}
+}
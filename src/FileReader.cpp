@@ -0,0 +1,133 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <memory>
+
+#include <ert/multipart/FileReader.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+namespace {
+
+bool mapFd(int fd, off_t offset, size_t size, const FileSink &sink, bool &mapped)
+{
+    // Mapping starts at a page boundary:
+    off_t page = (off_t)sysconf(_SC_PAGESIZE);
+    off_t start = offset - (offset % page);
+    size_t skip = (size_t)(offset - start);
+
+    void *map = mmap(nullptr, size + skip, PROT_READ, MAP_PRIVATE, fd, start);
+    mapped = (map != MAP_FAILED);
+    if (!mapped) {
+        return false;
+    }
+    madvise(map, size + skip, MADV_SEQUENTIAL);
+
+    bool result = sink((const char*)map + skip, size);
+    munmap(map, size + skip);
+    if (result) {
+        lseek(fd, 0, SEEK_END); // consumed, as read() would
+    }
+    return result;
+}
+
+bool streamFd(int fd, const FileSink &sink)
+{
+    std::unique_ptr<char[]> block(new char[FileReadSize]);
+    for (;;) {
+        ssize_t length = read(fd, block.get(), FileReadSize);
+        if (length < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (length == 0) {
+            return true;
+        }
+        if (!sink(block.get(), length)) {
+            return false;
+        }
+    }
+}
+
+}
+
+bool readFd(int fd, const FileSink &sink)
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return false;
+    }
+
+    if (S_ISREG(st.st_mode)) {
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        if (offset >= 0) {
+            if (offset >= st.st_size) {
+                return true; // nothing left
+            }
+            bool mapped;
+            bool result = mapFd(fd, offset, (size_t)(st.st_size - offset), sink, mapped);
+            if (mapped) {
+                return result;
+            }
+            // not mappable (i.e. some special filesystems): read below
+        }
+    }
+
+    return streamFd(fd, sink);
+}
+
+bool readFile(const std::string &path, const FileSink &sink)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool result = readFd(fd, sink);
+    close(fd);
+    return result;
+}
+
+}
+}
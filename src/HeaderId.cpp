@@ -0,0 +1,82 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <strings.h>
+
+#include <ert/multipart/HeaderId.hpp>
+
+#include "Text.hpp"
+
+
+namespace ert
+{
+namespace multipart
+{
+
+std::string_view headerParameter(std::string_view value, std::string_view name)
+{
+    size_t pos = value.find(';');
+    while (pos != std::string_view::npos) {
+        value.remove_prefix(pos + 1);
+
+        size_t equal = value.find('=');
+        if (equal == std::string_view::npos) {
+            break;
+        }
+        std::string_view parameterName = trim(value.substr(0, equal));
+        std::string_view rest = trim(value.substr(equal + 1));
+        std::string_view parameterValue;
+        if (!rest.empty() && rest.front() == '"') { // may contain separators
+            size_t quote = rest.find('"', 1);
+            parameterValue = rest.substr(1, (quote == std::string_view::npos) ? std::string_view::npos : quote - 1);
+            value = (quote == std::string_view::npos) ? std::string_view() : rest.substr(quote + 1);
+        }
+        else {
+            size_t end = rest.find(';');
+            parameterValue = trim(rest.substr(0, end));
+            value = (end == std::string_view::npos) ? std::string_view() : rest.substr(end);
+        }
+
+        if (parameterName.size() == name.size() && strncasecmp(parameterName.data(), name.data(), name.size()) == 0) {
+            return parameterValue;
+        }
+        pos = value.find(';');
+    }
+
+    return std::string_view();
+}
+
+}
+}
@@ -0,0 +1,191 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+
+#include <ert/multipart/Metrics.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+namespace {
+
+// 1us to 10s
+const uint64_t LatencyBounds[Histogram::Buckets] = {
+    1000, 5000, 10000, 50000, 100000, 500000,
+    1000000, 5000000, 10000000, 50000000, 100000000, 500000000,
+    1000000000, 2500000000, 5000000000, 10000000000
+};
+
+// 64 bytes to 2 GiB
+const uint64_t SizeBounds[Histogram::Buckets] = {
+    1ull << 6, 1ull << 8, 1ull << 10, 1ull << 12, 1ull << 14, 1ull << 16, 1ull << 18, 1ull << 20,
+    1ull << 22, 1ull << 24, 1ull << 26, 1ull << 27, 1ull << 28, 1ull << 29, 1ull << 30, 1ull << 31
+};
+
+struct CounterInfo {
+    const char *name;
+    const char *help;
+};
+
+const CounterInfo CounterInfos[Metrics::Counters] = {
+    { "bytes_total", "Body bytes fed" },
+    { "decodes_total", "Bodies finished" },
+    { "parts_total", "Parts decoded" },
+    { "skipped_parts_total", "Parts rejected by the part filter" },
+    { "headers_total", "Part headers decoded" },
+    { "callbacks_total", "Consumer callbacks" },
+    { "errors_total", "Malformed bodies" }
+};
+
+void appendSample(std::string &output, const std::string &name, const char *labels, uint64_t value) {
+    char text[32];
+    snprintf(text, sizeof(text), " %llu\n", (unsigned long long)value);
+    output += name;
+    output += labels;
+    output += text;
+}
+
+void appendSample(std::string &output, const std::string &name, const char *labels, double value) {
+    char text[32];
+    snprintf(text, sizeof(text), " %.9g\n", value);
+    output += name;
+    output += labels;
+    output += text;
+}
+
+void appendHeader(std::string &output, const std::string &name, const char *type, const char *help) {
+    output += "# HELP " + name + " " + help + "\n";
+    output += "# TYPE " + name + " " + type + "\n";
+}
+
+}
+
+Histogram::Histogram(const uint64_t (&bounds)[Buckets], double scale)
+{
+    for (size_t k = 0; k < Buckets; k++) {
+        bounds_[k] = bounds[k];
+    }
+    scale_ = scale;
+    for (auto &count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    sum_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::count() const
+{
+    uint64_t result = 0;
+    for (auto &count : counts_) {
+        result += count.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void Histogram::merge(const Histogram &other)
+{
+    for (size_t k = 0; k <= Buckets; k++) {
+        counts_[k].fetch_add(other.counts_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    sum_.fetch_add(other.sum(), std::memory_order_relaxed);
+}
+
+void Histogram::exportText(const std::string &name, std::string &output) const
+{
+    uint64_t cumulative = 0;
+    char label[48];
+    for (size_t k = 0; k < Buckets; k++) {
+        cumulative += counts_[k].load(std::memory_order_relaxed);
+        snprintf(label, sizeof(label), "{le=\"%.10g\"}", bounds_[k] * scale_);
+        appendSample(output, name + "_bucket", label, cumulative);
+    }
+    cumulative += counts_[Buckets].load(std::memory_order_relaxed);
+    appendSample(output, name + "_bucket", "{le=\"+Inf\"}", cumulative);
+    if (scale_ == 1) {
+        appendSample(output, name + "_sum", "", sum());
+    }
+    else {
+        appendSample(output, name + "_sum", "", sum() * scale_);
+    }
+    appendSample(output, name + "_count", "", cumulative);
+}
+
+Metrics::Metrics() : latency_(LatencyBounds, 1e-9), part_size_(SizeBounds), error_offset_(SizeBounds)
+{
+    for (auto &counter : counters_) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::merge(const Metrics &other)
+{
+    for (size_t k = 0; k < Counters; k++) {
+        counters_[k].fetch_add(other.counters_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    latency_.merge(other.latency_);
+    part_size_.merge(other.part_size_);
+    error_offset_.merge(other.error_offset_);
+}
+
+std::string Metrics::prometheus(const std::string &prefix) const
+{
+    std::string result;
+
+    for (size_t k = 0; k < Counters; k++) {
+        std::string name = prefix + "_" + CounterInfos[k].name;
+        appendHeader(result, name, "counter", CounterInfos[k].help);
+        appendSample(result, name, "", counters_[k].load(std::memory_order_relaxed));
+    }
+
+    std::string name = prefix + "_decode_duration_seconds";
+    appendHeader(result, name, "histogram", "Body decode latency, from the first chunk to finish");
+    latency_.exportText(name, result);
+
+    name = prefix + "_part_size_bytes";
+    appendHeader(result, name, "histogram", "Part data size");
+    part_size_.exportText(name, result);
+
+    name = prefix + "_error_offset_bytes";
+    appendHeader(result, name, "histogram", "Offset of decoding errors within the body");
+    error_offset_.exportText(name, result);
+
+    return result;
+}
+
+}
+}
@@ -0,0 +1,128 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <strings.h>
+
+#include <ert/multipart/MultipartView.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+std::string_view Part::header(std::string_view name) const
+{
+    for (const auto &header : headers) {
+        if (header.first.size() == name.size() && strncasecmp(header.first.data(), name.data(), name.size()) == 0) {
+            return header.second;
+        }
+    }
+    return std::string_view();
+}
+
+std::string_view Part::header(HeaderId id) const
+{
+    for (const auto &header : headers) {
+        if (headerId(header.first) == id) {
+            return header.second;
+        }
+    }
+    return std::string_view();
+}
+
+// Collects one part and stops the parser at its end:
+struct MultipartView::Handler : ParserHandler {
+    Part &part;
+    std::string_view name;
+    const char *body;
+    size_t length;
+
+    Handler(Part &p) : part(p), body(nullptr), length(0) {}
+
+    int onHeaderField(const char *at, size_t len) {
+        name = std::string_view(at, len);
+        return 0;
+    }
+    int onHeaderValue(const char *at, size_t len) {
+        part.headers.emplace_back(name, std::string_view(at, len));
+        return 0;
+    }
+    int onPartData(const char *at, size_t len) {
+        if (!body) body = at; // first fragment always starts in the buffer
+        length += len;
+        return 0;
+    }
+    int onPartDataEnd() {
+        part.body = std::string_view(body, length);
+        return 1;
+    }
+};
+
+MultipartView::MultipartView(std::string_view body, const std::string& boundary) : buffer_(body), offset_(0), done_(false), failed_(false)
+{
+    multipart_parser_construct(&parser_, boundary.c_str(), nullptr);
+}
+
+MultipartView::~MultipartView()
+{
+    multipart_parser_destroy(&parser_);
+}
+
+bool MultipartView::next()
+{
+    if (done_) {
+        return false;
+    }
+
+    part_.headers.clear();
+    part_.body = std::string_view();
+
+    Handler handler(part_);
+    size_t remaining = buffer_.size() - offset_;
+    size_t parsed = multipart_parser_execute(&parser_, handler, buffer_.data() + offset_, remaining);
+    offset_ += parsed;
+
+    if (handler.body && parser_.state == s_part_data_almost_end) { // stopped at part end
+        return true;
+    }
+
+    done_ = true;
+    failed_ = (parsed != remaining || !multipart_parser_completed(&parser_));
+    return false;
+}
+
+}
+}
@@ -0,0 +1,292 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <ert/multipart/ParallelDecoder.hpp>
+
+
+#define LF 10
+#define CR 13
+
+
+namespace ert
+{
+namespace multipart
+{
+
+thread_local size_t ParallelDecoder::part_ = 0;
+
+ParallelDecoder::ParallelDecoder(size_t threads)
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    work_ = nullptr;
+    generation_ = 0;
+    pending_ = 0;
+    stop_ = false;
+    data_ = nullptr;
+    length_ = 0;
+    count_ = 0;
+    next_ = 0;
+    abort_ = false;
+    slice_size_ = 1 << 20;
+    ordered_ = true;
+    state_ = s_start;
+    index_ = 0;
+
+    parsers_.resize(threads); // never resized again: parsers point to their own buffers
+    for (multipart_parser &parser : parsers_) {
+        multipart_parser_construct(&parser, "", nullptr);
+    }
+
+    for (size_t worker = 1; worker < threads; worker++) {
+        threads_.emplace_back(&ParallelDecoder::loop, this, worker);
+    }
+}
+
+ParallelDecoder::~ParallelDecoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &thread : threads_) {
+        thread.join();
+    }
+
+    for (multipart_parser &parser : parsers_) {
+        multipart_parser_destroy(&parser);
+    }
+}
+
+void ParallelDecoder::loop(size_t worker)
+{
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [&]() {
+            return stop_ || generation_ != generation;
+        });
+        if (stop_) {
+            return;
+        }
+        generation = generation_;
+        const std::function<void(size_t)> *work = work_;
+
+        lock.unlock();
+        (*work)(worker);
+        lock.lock();
+
+        if (--pending_ == 0) {
+            finished_.notify_one();
+        }
+    }
+}
+
+void ParallelDecoder::run(const std::function<void(size_t)> &work)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        work_ = &work;
+        generation_++;
+        pending_ = threads_.size();
+    }
+    wake_.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [&]() {
+        return pending_ == 0;
+    });
+}
+
+void ParallelDecoder::arm(const std::string &boundary, const char *data, size_t length)
+{
+    for (multipart_parser &parser : parsers_) {
+        multipart_parser_reset(&parser, boundary.c_str());
+    }
+
+    data_ = data;
+    length_ = length;
+    count_ = 0;
+    next_ = 0;
+    abort_ = false;
+}
+
+void ParallelDecoder::scan()
+{
+    size_t slices = (length_ + slice_size_ - 1) / slice_size_;
+    if (found_.size() < slices) {
+        found_.resize(slices);
+    }
+
+    run([&](size_t worker) {
+        multipart_parser *p = &parsers_[worker];
+        size_t delimiter_length = p->boundary_length + 2; // "\r\n" + "--boundary"
+        size_t s;
+
+        while ((s = next_.fetch_add(1, std::memory_order_relaxed)) < slices) {
+            std::vector<size_t> &found = found_[s];
+            found.clear();
+
+            // Delimiters starting within the slice may end beyond it:
+            size_t offset = s * slice_size_;
+            size_t to = std::min(offset + slice_size_, length_);
+            size_t window = std::min(to + delimiter_length - 1, length_);
+            while (offset < to) {
+                offset += multipart_parser_scan(p, data_ + offset, window - offset);
+                if (offset >= to) {
+                    break;
+                }
+                if (offset + delimiter_length <= length_ && data_[offset] == CR && data_[offset + 1] == LF
+                        && memcmp(data_ + offset + 2, p->multipart_boundary, p->boundary_length) == 0) {
+                    found.push_back(offset);
+                }
+                offset++;
+            }
+        }
+    });
+
+    delimiters_.clear();
+    for (size_t s = 0; s < slices; s++) {
+        delimiters_.insert(delimiters_.end(), found_[s].begin(), found_[s].end());
+    }
+    next_ = 0;
+}
+
+// Offset of the part data following the delimiter which ends at 'position', applying
+// the parser rules for the headers in between (0 if the parser would not reach data)
+static size_t multipart_part_data(const char *data, size_t length, size_t position)
+{
+    if (position + 2 > length || data[position] != CR || data[position + 1] != LF) {
+        return 0; // closing delimiter, malformed or truncated
+    }
+
+    size_t i = position + 2;
+    while (i < length) {
+        // Header field, or the empty line:
+        char c;
+        while (i < length && (c = data[i]) != ':') {
+            if (c == CR) {
+                return (i + 1 < length && data[i + 1] == LF) ? i + 2 : 0;
+            }
+            if (!HeaderChars.lower[(unsigned char)c]) {
+                return 0;
+            }
+            i++;
+        }
+        if (i == length) {
+            return 0;
+        }
+
+        // Header value:
+        const char *cr = (const char*)memchr(data + i, CR, length - i);
+        if (!cr || (size_t)(cr - data) + 1 >= length || cr[1] != LF) {
+            return 0;
+        }
+        i = (cr - data) + 2;
+    }
+
+    return 0;
+}
+
+void ParallelDecoder::plan()
+{
+    const multipart_parser *p = &parsers_[0];
+    size_t delimiter_length = p->boundary_length + 2;
+    bool valid = (length_ >= p->boundary_length && memcmp(data_, p->multipart_boundary, p->boundary_length) == 0);
+    size_t begin = 0;
+    size_t position = p->boundary_length; // after the delimiter
+    size_t d = 0;
+
+    while (true) {
+        if (count_ == tasks_.size()) {
+            tasks_.emplace_back(new Task());
+        }
+        Task &task = *tasks_[count_++];
+        task.begin = begin;
+        task.end = 0;
+        task.parsed = 0;
+        task.stopped = false;
+        task.state = s_start;
+        task.index = 0;
+        task.events.clear();
+        task.storage.clear();
+        task.done = false;
+
+        size_t data = valid ? multipart_part_data(data_, length_, position) : 0;
+        if (!data) {
+            break;
+        }
+        while (d < delimiters_.size() && delimiters_[d] < data) {
+            d++;
+        }
+        if (d == delimiters_.size()) {
+            break;
+        }
+        task.end = begin = position = delimiters_[d] + delimiter_length;
+    }
+}
+
+void ParallelDecoder::locateStop(Task &task, size_t hooks)
+{
+    // Delivery runs on the calling thread, whose parser is idle meanwhile:
+    Stopper stopper{hooks};
+    parse(task, 0, stopper);
+}
+
+size_t ParallelDecoder::conclude()
+{
+    for (size_t k = 0; k < count_; k++) {
+        const Task &task = *tasks_[k];
+        state_ = task.state;
+        index_ = task.index;
+        if (task.stopped || !task.end || task.parsed != task.end) {
+            return task.parsed;
+        }
+    }
+
+    return length_;
+}
+
+}
+}
@@ -0,0 +1,368 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MULTIPART_SCAN_X86
+#include <immintrin.h>
+#endif
+
+#include <ert/multipart/Parser.hpp>
+
+
+#define LF 10
+#define CR 13
+
+
+namespace ert
+{
+namespace multipart
+{
+
+const char *multipart_state_name(unsigned char state) {
+    static const char *names[] = {
+        "s_uninitialized", "s_start", "s_start_boundary", "s_header_field_start", "s_header_field",
+        "s_headers_almost_done", "s_header_value_start", "s_header_value", "s_header_value_almost_done",
+        "s_part_data_start", "s_part_data", "s_part_data_almost_boundary", "s_part_data_boundary",
+        "s_part_data_almost_end", "s_part_data_end", "s_part_data_final_hyphen", "s_end"
+    };
+    return (state >= s_uninitialized && state <= s_end) ? names[state - s_uninitialized] : "unknown state";
+}
+
+// Delimiter scanning:
+//
+// Part data is scanned in bulk for the next position which could start the
+// delimiter ("\r\n" + "--boundary"). A candidate is a position whose bytes
+// match the delimiter completely or, at the end of the buffer, match a prefix
+// of it (the remainder may come in the next buffer). Every other byte is pure
+// part data and is emitted in one piece without entering the state machine.
+
+typedef size_t (*multipart_scan_fn)(const char *buf, size_t len, const char *boundary, size_t boundary_length);
+
+// Verifies the candidate starting at 'buf' (a CR), truncated to the available length
+static inline bool multipart_candidate(const char *buf, size_t len, const char *boundary, size_t boundary_length) {
+    if (len < 2) return true;
+    if (buf[1] != LF) return false;
+    size_t available = len - 2;
+    return (memcmp(buf + 2, boundary, (available < boundary_length) ? available : boundary_length) == 0);
+}
+
+static size_t multipart_scan_scalar(const char *buf, size_t len, const char *boundary, size_t boundary_length) {
+    const char *cr = buf;
+    const char *end = buf + len;
+    while ((cr = (const char*)memchr(cr, CR, end - cr))) {
+        if (multipart_candidate(cr, end - cr, boundary, boundary_length)) {
+            return cr - buf;
+        }
+        cr++;
+    }
+    return len;
+}
+
+#ifdef MULTIPART_SCAN_X86
+// Candidates must show "\r\n--": four shifted compares select them 16 (32) bytes at a time.
+// The last bytes of the buffer are left to the scalar scan, which also detects truncated candidates.
+
+__attribute__((target("sse2")))
+static size_t multipart_scan_sse2(const char *buf, size_t len, const char *boundary, size_t boundary_length) {
+    const __m128i cr = _mm_set1_epi8(CR);
+    const __m128i lf = _mm_set1_epi8(LF);
+    const __m128i hyphen = _mm_set1_epi8('-');
+    size_t i = 0;
+
+    while (i + 16 + 3 <= len) {
+        __m128i m = _mm_and_si128(
+                        _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(buf + i)), cr),
+                                      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(buf + i + 1)), lf)),
+                        _mm_and_si128(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(buf + i + 2)), hyphen),
+                                      _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(buf + i + 3)), hyphen)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(m);
+        while (mask) {
+            size_t pos = i + __builtin_ctz(mask);
+            if (multipart_candidate(buf + pos, len - pos, boundary, boundary_length)) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+
+    return i + multipart_scan_scalar(buf + i, len - i, boundary, boundary_length);
+}
+
+__attribute__((target("avx2")))
+static size_t multipart_scan_avx2(const char *buf, size_t len, const char *boundary, size_t boundary_length) {
+    const __m256i cr = _mm256_set1_epi8(CR);
+    const __m256i lf = _mm256_set1_epi8(LF);
+    const __m256i hyphen = _mm256_set1_epi8('-');
+    size_t i = 0;
+
+    while (i + 32 + 3 <= len) {
+        __m256i m = _mm256_and_si256(
+                        _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + i)), cr),
+                                         _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + i + 1)), lf)),
+                        _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + i + 2)), hyphen),
+                                         _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + i + 3)), hyphen)));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(m);
+        while (mask) {
+            size_t pos = i + __builtin_ctz(mask);
+            if (multipart_candidate(buf + pos, len - pos, boundary, boundary_length)) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+
+    return i + multipart_scan_sse2(buf + i, len - i, boundary, boundary_length);
+}
+#endif
+
+// Horspool search of the whole delimiter. The shift table is built once at multipart_parser_init.
+// Skipped positions cannot start the delimiter, not even truncated at the end of the buffer, so
+// the remaining window shorter than the delimiter is left to the scalar scan.
+static size_t multipart_scan_horspool(const char *buf, size_t len, const char *boundary, size_t boundary_length, const unsigned char *skip) {
+    size_t last = boundary_length + 1; // delimiter length - 1
+    char tail = boundary[boundary_length - 1];
+    size_t pos = 0;
+
+    while (pos + last < len) {
+        char c = buf[pos + last];
+        if (c == tail && buf[pos] == CR && buf[pos + 1] == LF && memcmp(buf + pos + 2, boundary, boundary_length - 1) == 0) {
+            return pos;
+        }
+        pos += skip[(unsigned char)c];
+    }
+
+    return pos + multipart_scan_scalar(buf + pos, len - pos, boundary, boundary_length);
+}
+
+static void multipart_skip_table(unsigned char *skip, const char *boundary, size_t boundary_length) {
+    size_t length = boundary_length + 2;
+    size_t shift = (length < 255) ? length : 255;
+    memset(skip, (int)shift, 256);
+
+    for (size_t k = 0; k + 1 < length; k++) {
+        unsigned char c = (k == 0) ? CR : (k == 1) ? LF : boundary[k - 2];
+        shift = length - 1 - k;
+        skip[c] = (shift < 255) ? shift : 255;
+    }
+}
+
+static multipart_scan_fn multipart_scan_select(const char **isa) {
+#ifdef MULTIPART_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *isa = "avx2";
+        return multipart_scan_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        *isa = "sse2";
+        return multipart_scan_sse2;
+    }
+#endif
+    *isa = "scalar";
+    return multipart_scan_scalar;
+}
+
+// Resolved on first use (safe for parsers created during static initialization)
+static size_t multipart_scan_resolve(const char *buf, size_t len, const char *boundary, size_t boundary_length);
+static std::atomic<multipart_scan_fn> multipart_scan_impl(multipart_scan_resolve);
+static std::atomic<const char *> multipart_scan_isa_name(nullptr);
+
+static size_t multipart_scan_resolve(const char *buf, size_t len, const char *boundary, size_t boundary_length) {
+    const char *isa;
+    multipart_scan_fn fn = multipart_scan_select(&isa);
+    multipart_scan_isa_name.store(isa, std::memory_order_relaxed);
+    multipart_scan_impl.store(fn, std::memory_order_relaxed);
+    return fn(buf, len, boundary, boundary_length);
+}
+
+size_t multipart_parser_scan(multipart_parser* p, const char *buf, size_t len) {
+    if (p->matcher == MULTIPART_MATCHER_HORSPOOL) {
+        return multipart_scan_horspool(buf, len, p->multipart_boundary, p->boundary_length, p->skip);
+    }
+    return multipart_scan_impl.load(std::memory_order_relaxed)(buf, len, p->multipart_boundary, p->boundary_length);
+}
+
+const char *multipart_parser_scan_isa() {
+    const char *isa = multipart_scan_isa_name.load(std::memory_order_relaxed);
+    if (!isa) {
+        multipart_scan_select(&isa);
+    }
+    return isa;
+}
+
+// Boundary and lookbehind storage for boundary_length (boundary + "--"): inline buffer
+// within the RFC 2046 limit, heap otherwise
+static int multipart_parser_arm(multipart_parser* p, const char *boundary) {
+
+    size_t boundary_length = strlen(boundary) + 2; // boundary must be prefixed by "--"
+
+    if (boundary_length > p->capacity) {
+        char *heap = (char*)malloc(2*boundary_length + 9);
+        if (!heap) {
+            return -1;
+        }
+        free(p->heap);
+        p->heap = heap;
+        p->capacity = boundary_length;
+        p->multipart_boundary = heap;
+        p->lookbehind = (heap + boundary_length + 1);
+    }
+
+    strcpy(p->multipart_boundary, "--");
+    strcpy(p->multipart_boundary + 2, boundary);
+    p->boundary_length = boundary_length;
+    multipart_skip_table(p->skip, p->multipart_boundary, p->boundary_length);
+
+    p->index = 0;
+    p->state = s_start;
+    p->skipping = 0;
+    return 0;
+}
+
+int multipart_parser_construct
+(multipart_parser* p, const char *boundary, const multipart_parser_settings* settings) {
+
+    p->data = NULL;
+    p->heap = NULL;
+    p->capacity = MULTIPART_BOUNDARY_MAX + 2;
+    p->multipart_boundary = p->buffer;
+    p->lookbehind = (p->buffer + p->capacity + 1);
+
+    p->matcher = MULTIPART_MATCHER_SIMD;
+    p->settings = settings;
+
+    return multipart_parser_arm(p, boundary);
+}
+
+void multipart_parser_destroy(multipart_parser* p) {
+    free(p->heap);
+    p->heap = NULL;
+}
+
+multipart_parser* multipart_parser_init
+(const char *boundary, const multipart_parser_settings* settings) {
+
+    multipart_parser* p = (multipart_parser*)malloc(sizeof(multipart_parser));
+
+    if (p && multipart_parser_construct(p, boundary, settings) != 0) {
+        free(p);
+        return NULL;
+    }
+
+    return p;
+}
+
+int multipart_parser_reset(multipart_parser* p, const char *boundary) {
+    return multipart_parser_arm(p, boundary);
+}
+
+void multipart_parser_rewind(multipart_parser* p) {
+    p->index = 0;
+    p->state = s_start;
+    p->skipping = 0;
+}
+
+int multipart_parser_completed(multipart_parser* p) {
+    return (p->state == s_end);
+}
+
+void multipart_parser_set_matcher(multipart_parser* p, multipart_matcher matcher) {
+    p->matcher = matcher;
+}
+
+const char *multipart_parser_tracing() {
+    static const char *modes[] = { "OFF", "STATE", "BYTE" };
+    return modes[ERT_MULTIPART_TRACING];
+}
+
+void multipart_parser_free(multipart_parser* p) {
+    multipart_parser_destroy(p);
+    free(p);
+}
+
+void multipart_parser_set_data(multipart_parser *p, void *data) {
+    p->data = data;
+}
+
+void *multipart_parser_get_data(multipart_parser *p) {
+    return p->data;
+}
+
+// Callbacks handler for the C API:
+namespace {
+
+struct SettingsHandler {
+    multipart_parser* p;
+    const multipart_parser_settings* settings;
+
+    int onPartDataBegin() {
+        return settings->on_part_data_begin ? settings->on_part_data_begin(p) : 0;
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return settings->on_header_field ? settings->on_header_field(p, at, length) : 0;
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return settings->on_header_value ? settings->on_header_value(p, at, length) : 0;
+    }
+    int onHeadersComplete() {
+        return settings->on_headers_complete ? settings->on_headers_complete(p) : 0;
+    }
+    int onPartData(const char *at, size_t length) {
+        return settings->on_part_data ? settings->on_part_data(p, at, length) : 0;
+    }
+    int onPartDataEnd() {
+        return settings->on_part_data_end ? settings->on_part_data_end(p) : 0;
+    }
+    int onBodyEnd() {
+        return settings->on_body_end ? settings->on_body_end(p) : 0;
+    }
+};
+
+}
+
+size_t multipart_parser_execute(multipart_parser* p, const char *buf, size_t len) {
+    SettingsHandler handler{p, p->settings};
+    return multipart_parser_execute(p, handler, buf, len);
+}
+
+}
+}
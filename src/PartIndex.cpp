@@ -0,0 +1,156 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <strings.h>
+
+#include <ert/multipart/Parser.hpp>
+#include <ert/multipart/PartIndex.hpp>
+
+#include "Text.hpp"
+
+
+namespace ert
+{
+namespace multipart
+{
+
+namespace {
+
+// Content-ID as a key: "<id>" or "cid:id" become "id"
+std::string_view identifier(std::string_view id) {
+    id = trim(id);
+    if (id.size() >= 4 && strncasecmp(id.data(), "cid:", 4) == 0) id.remove_prefix(4);
+    if (id.size() >= 2 && id.front() == '<' && id.back() == '>') id = id.substr(1, id.size() - 2);
+    return id;
+}
+
+}
+
+// Records the header values and data spans of every part:
+struct PartIndex::Handler : ParserHandler {
+    PartIndex &index;
+    const char *base;
+    HeaderId id;
+    IndexedPart part;
+    bool data;
+
+    Handler(PartIndex &i) : index(i), base(i.buffer_.data()), id(HeaderId::Unknown), data(false) {}
+
+    Span span(std::string_view text) {
+        return Span{(size_t)(text.data() - base), text.size()};
+    }
+
+    int onPartDataBegin() {
+        part = IndexedPart();
+        data = false;
+        return 0;
+    }
+    int onHeaderField(const char *at, size_t length) {
+        id = headerId(std::string_view(at, length));
+        return 0;
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        std::string_view value(at, length);
+        switch (id) {
+        case HeaderId::ContentType:
+            part.contentType = span(trim(value));
+            break;
+        case HeaderId::ContentId:
+            part.contentId = span(identifier(value));
+            break;
+        case HeaderId::ContentLocation:
+            part.contentLocation = span(trim(value));
+            break;
+        default:
+            break;
+        }
+        id = HeaderId::Unknown;
+        return 0;
+    }
+    int onPartData(const char *at, size_t length) {
+        if (!data) { // first fragment always starts in the buffer
+            part.body.offset = at - base;
+            data = true;
+        }
+        part.body.length += length;
+        return 0;
+    }
+    int onPartDataEnd() {
+        if (!data) part.body.offset = 0;
+        size_t position = index.parts_.size();
+        index.parts_.push_back(part);
+        if (part.contentId.length) index.by_id_.emplace(std::string(index.view(part.contentId)), position);
+        if (part.contentLocation.length) index.by_location_.emplace(std::string(index.view(part.contentLocation)), position);
+        return 0;
+    }
+};
+
+bool PartIndex::build(std::string_view body, const std::string& boundary)
+{
+    buffer_ = body;
+    parts_.clear();
+    by_id_.clear();
+    by_location_.clear();
+
+    multipart_parser parser;
+    multipart_parser_construct(&parser, boundary.c_str(), nullptr);
+    Handler handler(*this);
+    size_t parsed = multipart_parser_execute(&parser, handler, body.data(), body.size());
+    failed_ = (parsed != body.size() || !multipart_parser_completed(&parser));
+    multipart_parser_destroy(&parser);
+
+    return !failed_;
+}
+
+const IndexedPart *PartIndex::findById(std::string_view contentId) const
+{
+    auto it = by_id_.find(std::string(identifier(contentId)));
+    return (it != by_id_.end()) ? &parts_[it->second] : nullptr;
+}
+
+const IndexedPart *PartIndex::findByLocation(std::string_view location) const
+{
+    auto it = by_location_.find(std::string(trim(location)));
+    return (it != by_location_.end()) ? &parts_[it->second] : nullptr;
+}
+
+const IndexedPart *PartIndex::root(std::string_view contentType) const
+{
+    std::string_view start = headerParameter(contentType, "start");
+    return start.empty() ? at(0) : findById(start);
+}
+
+}
+}
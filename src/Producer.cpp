@@ -0,0 +1,209 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+
+#include <ert/multipart/Producer.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+namespace {
+
+const char CRLF[] = "\r\n";
+
+size_t headersSize(const std::vector<Producer::Header> &headers, size_t first, size_t count) {
+    size_t result = 0;
+    for (size_t k = first; k < first + count; k++) {
+        result += headers[k].first.size() + 2 + headers[k].second.size() + 2; // "name: value\r\n"
+    }
+    return result;
+}
+
+}
+
+Producer::Producer() : generated_(true)
+{
+}
+
+Producer::Producer(const std::string& boundary) : boundary_(boundary), generated_(false)
+{
+}
+
+std::string Producer::randomBoundary(size_t length)
+{
+    static const char chars[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    thread_local std::mt19937_64 rng(std::random_device{}());
+
+    std::string result(length, '0');
+    for (char &c : result) {
+        c = chars[rng() % (sizeof(chars) - 1)];
+    }
+    return result;
+}
+
+bool Producer::collides(const std::string &boundary) const
+{
+    for (const PartEntry &part : parts_) {
+        if (part.body.find(boundary) != std::string_view::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::string &Producer::ensureBoundary()
+{
+    // Parts added later are checked against the boundary by appendPart(), so the
+    // whole content is only scanned when a boundary is generated:
+    if (generated_ && boundary_.empty()) {
+        do {
+            boundary_ = randomBoundary();
+        } while (collides(boundary_));
+    }
+    return boundary_;
+}
+
+void Producer::appendPart(size_t firstHeader, std::string_view body)
+{
+    parts_.push_back(PartEntry{firstHeader, headers_.size() - firstHeader, body});
+    if (generated_ && !boundary_.empty() && body.find(boundary_) != std::string_view::npos) {
+        boundary_.clear(); // generated again when needed
+    }
+}
+
+void Producer::addPart(std::initializer_list<Header> headers, std::string_view body)
+{
+    size_t first = headers_.size();
+    headers_.insert(headers_.end(), headers.begin(), headers.end());
+    appendPart(first, body);
+}
+
+void Producer::addPart(const std::vector<Header> &headers, std::string_view body)
+{
+    size_t first = headers_.size();
+    headers_.insert(headers_.end(), headers.begin(), headers.end());
+    appendPart(first, body);
+}
+
+void Producer::clear()
+{
+    headers_.clear();
+    parts_.clear();
+    if (generated_) boundary_.clear();
+}
+
+const std::string &Producer::boundary()
+{
+    return ensureBoundary();
+}
+
+size_t Producer::size()
+{
+    size_t delimiter = 2 + ensureBoundary().size() + 2; // "--boundary\r\n"
+    size_t result = 0;
+
+    for (const PartEntry &part : parts_) {
+        result += delimiter + headersSize(headers_, part.firstHeader, part.headers) + 2 + part.body.size() + 2;
+    }
+    return result + delimiter + 2; // "--boundary--\r\n"
+}
+
+void Producer::encode(std::string &output)
+{
+    const std::string &boundary = ensureBoundary();
+    output.clear();
+    output.reserve(size());
+
+    for (const PartEntry &part : parts_) {
+        output.append("--").append(boundary).append(CRLF, 2);
+        for (size_t k = part.firstHeader; k < part.firstHeader + part.headers; k++) {
+            output.append(headers_[k].first).append(": ").append(headers_[k].second).append(CRLF, 2);
+        }
+        output.append(CRLF, 2).append(part.body).append(CRLF, 2);
+    }
+    output.append("--").append(boundary).append("--").append(CRLF, 2);
+}
+
+std::string Producer::encode()
+{
+    std::string result;
+    encode(result);
+    return result;
+}
+
+const std::vector<struct iovec> &Producer::iovecs()
+{
+    const std::string &boundary = ensureBoundary();
+
+    // Framing first (its buffer must not move once referred):
+    size_t bodies = 0;
+    for (const PartEntry &part : parts_) bodies += part.body.size();
+    framing_.clear();
+    framing_.reserve(size() - bodies);
+    ends_.clear();
+
+    for (size_t n = 0; n < parts_.size(); n++) {
+        const PartEntry &part = parts_[n];
+        if (n > 0) framing_.append(CRLF, 2);
+        framing_.append("--").append(boundary).append(CRLF, 2);
+        for (size_t k = part.firstHeader; k < part.firstHeader + part.headers; k++) {
+            framing_.append(headers_[k].first).append(": ").append(headers_[k].second).append(CRLF, 2);
+        }
+        framing_.append(CRLF, 2);
+        ends_.push_back(framing_.size());
+    }
+    if (!parts_.empty()) framing_.append(CRLF, 2);
+    framing_.append("--").append(boundary).append("--").append(CRLF, 2);
+
+    iovecs_.clear();
+    size_t offset = 0;
+    for (size_t n = 0; n < parts_.size(); n++) {
+        iovecs_.push_back(iovec{(void*)(framing_.data() + offset), ends_[n] - offset});
+        offset = ends_[n];
+        if (!parts_[n].body.empty()) {
+            iovecs_.push_back(iovec{(void*)parts_[n].body.data(), parts_[n].body.size()});
+        }
+    }
+    iovecs_.push_back(iovec{(void*)(framing_.data() + offset), framing_.size() - offset});
+
+    return iovecs_;
+}
+
+}
+}
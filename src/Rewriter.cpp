@@ -0,0 +1,454 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <strings.h>
+
+#include <ert/multipart/Parser.hpp>
+#include <ert/multipart/Rewriter.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+namespace {
+
+const char CRLF[] = "\r\n";
+
+bool sameName(std::string_view a, std::string_view b) {
+    return (a.size() == b.size() && strncasecmp(a.data(), b.data(), a.size()) == 0);
+}
+
+}
+
+// Records the data length of every part (the rest is located from the delimiters):
+struct Rewriter::Handler : ParserHandler {
+    std::vector<size_t> &lengths;
+    size_t length;
+
+    Handler(std::vector<size_t> &l) : lengths(l), length(0) {}
+
+    int onPartDataBegin() {
+        length = 0;
+        return 0;
+    }
+    int onPartData(const char *at, size_t size) {
+        length += size;
+        return 0;
+    }
+    int onPartDataEnd() {
+        lengths.push_back(length);
+        return 0;
+    }
+};
+
+bool Rewriter::load(std::string_view body, const std::string& boundary)
+{
+    buffer_ = body;
+    boundary_ = boundary;
+    parts_.clear();
+    headers_.clear();
+    insertions_.clear();
+    tail_ = 0;
+
+    std::vector<size_t> lengths;
+    multipart_parser parser;
+    multipart_parser_construct(&parser, boundary.c_str(), nullptr);
+    Handler handler(lengths);
+    size_t parsed = multipart_parser_execute(&parser, handler, body.data(), body.size());
+    failed_ = (parsed != body.size() || !multipart_parser_completed(&parser));
+    multipart_parser_destroy(&parser);
+    if (failed_) {
+        return false;
+    }
+
+    // Parsed body is "--boundary\r\n" headers "\r\n" data "\r\n" ... "--boundary--":
+    size_t delimiter = 2 + boundary_.size() + 2;
+    size_t offset = 0;
+    for (size_t length : lengths) {
+        PartEntry part{};
+        part.begin = offset;
+        part.bodyBegin = indexHeaders(part, offset + delimiter);
+        part.bodyEnd = part.bodyBegin + length;
+        parts_.push_back(part);
+        offset = part.bodyEnd + 2;
+    }
+    tail_ = offset;
+    original_headers_ = headers_.size();
+
+    return true;
+}
+
+size_t Rewriter::indexHeaders(PartEntry &part, size_t line)
+{
+    // As the parser does: a line without colon ends the headers (normally, the empty one)
+    part.firstHeader = part.originalHeader = headers_.size();
+    for (;;) {
+        size_t end = buffer_.find('\r', line);
+        size_t colon = buffer_.substr(line, end - line).find(':'); // searched within the line only
+        if (colon == std::string_view::npos) {
+            break;
+        }
+        colon += line;
+        size_t value = buffer_.substr(colon + 1, end - colon - 1).find_first_not_of(' ');
+        value = (value == std::string_view::npos) ? end : colon + 1 + value;
+        headers_.push_back(HeaderEntry{buffer_.substr(line, colon - line), buffer_.substr(value, end - value), line, end + 2 - line});
+        line = end + 2;
+    }
+    part.headers = part.originalHeaders = headers_.size() - part.firstHeader;
+
+    return buffer_.find('\r', line) + 2;
+}
+
+std::string_view Rewriter::body(size_t position) const
+{
+    if (position >= parts_.size()) {
+        return std::string_view();
+    }
+    const PartEntry &part = parts_[position];
+    return buffer_.substr(part.bodyBegin, part.bodyEnd - part.bodyBegin);
+}
+
+std::string_view Rewriter::header(size_t position, std::string_view name) const
+{
+    if (position < parts_.size()) {
+        const PartEntry &part = parts_[position];
+        for (size_t k = part.originalHeader; k < part.originalHeader + part.originalHeaders; k++) {
+            if (sameName(headers_[k].name, name)) return headers_[k].value;
+        }
+    }
+    return std::string_view();
+}
+
+size_t Rewriter::editHeaders(size_t position)
+{
+    // Edited list is the last one of headers_, so it may grow:
+    PartEntry &part = parts_[position];
+    if (!part.headersEdited || part.firstHeader + part.headers != headers_.size()) {
+        size_t first = headers_.size();
+        for (size_t k = 0; k < part.headers; k++) {
+            HeaderEntry entry = headers_[part.firstHeader + k];
+            headers_.push_back(entry);
+        }
+        part.firstHeader = first;
+        part.headersEdited = true;
+    }
+    return part.firstHeader;
+}
+
+void Rewriter::addHeaders(std::initializer_list<Header> headers, size_t &first, size_t &count)
+{
+    first = headers_.size();
+    for (const Header &header : headers) {
+        headers_.push_back(HeaderEntry{header.first, header.second, std::string_view::npos, 0});
+    }
+    count = headers.size();
+}
+
+void Rewriter::addHeaders(const std::vector<Header> &headers, size_t &first, size_t &count)
+{
+    first = headers_.size();
+    for (const Header &header : headers) {
+        headers_.push_back(HeaderEntry{header.first, header.second, std::string_view::npos, 0});
+    }
+    count = headers.size();
+}
+
+bool Rewriter::replacePart(size_t position, std::initializer_list<Header> headers, std::string_view body)
+{
+    if (position >= parts_.size()) {
+        return false;
+    }
+    PartEntry &part = parts_[position];
+    addHeaders(headers, part.firstHeader, part.headers);
+    part.headersEdited = true;
+    part.bodyReplaced = true;
+    part.body = body;
+    part.dropped = false;
+    return true;
+}
+
+bool Rewriter::replacePart(size_t position, const std::vector<Header> &headers, std::string_view body)
+{
+    if (position >= parts_.size()) {
+        return false;
+    }
+    PartEntry &part = parts_[position];
+    addHeaders(headers, part.firstHeader, part.headers);
+    part.headersEdited = true;
+    part.bodyReplaced = true;
+    part.body = body;
+    part.dropped = false;
+    return true;
+}
+
+bool Rewriter::replaceBody(size_t position, std::string_view body)
+{
+    if (position >= parts_.size()) {
+        return false;
+    }
+    parts_[position].bodyReplaced = true;
+    parts_[position].body = body;
+    return true;
+}
+
+bool Rewriter::dropPart(size_t position)
+{
+    if (position >= parts_.size()) {
+        return false;
+    }
+    parts_[position].dropped = true;
+    return true;
+}
+
+bool Rewriter::setHeader(size_t position, std::string_view name, std::string_view value)
+{
+    if (position >= parts_.size()) {
+        return false;
+    }
+    size_t first = editHeaders(position);
+    PartEntry &part = parts_[position];
+
+    // First occurrence takes the value, and the others are removed:
+    bool found = false;
+    size_t kept = first;
+    for (size_t k = first; k < first + part.headers; k++) {
+        HeaderEntry &entry = headers_[k];
+        if (sameName(entry.name, name)) {
+            if (found) continue;
+            found = true;
+            entry.value = value;
+            entry.line = std::string_view::npos;
+        }
+        headers_[kept++] = entry;
+    }
+    part.headers = kept - first;
+    headers_.resize(kept);
+
+    if (!found) {
+        headers_.push_back(HeaderEntry{name, value, std::string_view::npos, 0});
+        part.headers++;
+    }
+    return true;
+}
+
+bool Rewriter::removeHeader(size_t position, std::string_view name)
+{
+    if (position >= parts_.size()) {
+        return false;
+    }
+    size_t first = editHeaders(position);
+    PartEntry &part = parts_[position];
+
+    size_t kept = first;
+    for (size_t k = first; k < first + part.headers; k++) {
+        if (!sameName(headers_[k].name, name)) headers_[kept++] = headers_[k];
+    }
+    part.headers = kept - first;
+    headers_.resize(kept);
+    return true;
+}
+
+bool Rewriter::insertPart(size_t position, std::initializer_list<Header> headers, std::string_view body)
+{
+    if (failed_ || position > parts_.size()) {
+        return false;
+    }
+    Insertion insertion{position, 0, 0, body};
+    addHeaders(headers, insertion.firstHeader, insertion.headers);
+    insertions_.push_back(insertion);
+    return true;
+}
+
+bool Rewriter::insertPart(size_t position, const std::vector<Header> &headers, std::string_view body)
+{
+    if (failed_ || position > parts_.size()) {
+        return false;
+    }
+    Insertion insertion{position, 0, 0, body};
+    addHeaders(headers, insertion.firstHeader, insertion.headers);
+    insertions_.push_back(insertion);
+    return true;
+}
+
+void Rewriter::revert()
+{
+    headers_.resize(original_headers_);
+    insertions_.clear();
+    for (PartEntry &part : parts_) {
+        part.firstHeader = part.originalHeader;
+        part.headers = part.originalHeaders;
+        part.dropped = false;
+        part.bodyReplaced = false;
+        part.headersEdited = false;
+        part.body = std::string_view();
+    }
+}
+
+void Rewriter::emit(Piece::Source source, size_t offset, const char *data, size_t length)
+{
+    if (length == 0) {
+        return;
+    }
+    if (!pieces_.empty()) { // contiguous ranges are merged
+        Piece &last = pieces_.back();
+        if (last.source == source && (source == Piece::External ? last.data + last.length == data : last.offset + last.length == offset)) {
+            last.length += length;
+            return;
+        }
+    }
+    pieces_.push_back(Piece{source, offset, data, length});
+}
+
+void Rewriter::emitFraming(std::string_view text)
+{
+    emit(Piece::Framing, framing_.size(), nullptr, text.size());
+    framing_.append(text.data(), text.size());
+}
+
+void Rewriter::emitHeaders(size_t first, size_t count)
+{
+    for (size_t k = first; k < first + count; k++) {
+        const HeaderEntry &entry = headers_[k];
+        if (entry.line != std::string_view::npos) {
+            emit(Piece::Original, entry.line, nullptr, entry.length);
+            continue;
+        }
+        emitFraming(entry.name);
+        emitFraming(": ");
+        emitFraming(entry.value);
+        emitFraming(CRLF);
+    }
+}
+
+void Rewriter::emitInsertion(const Insertion &insertion)
+{
+    // Delimiter line and line breaks are taken from the first part of the original body:
+    size_t crlf = 2 + boundary_.size();
+    emit(Piece::Original, 0, nullptr, crlf + 2);
+    emitHeaders(insertion.firstHeader, insertion.headers);
+    emit(Piece::Original, crlf, nullptr, 2);
+    emit(Piece::External, 0, insertion.body.data(), insertion.body.size());
+    emit(Piece::Original, crlf, nullptr, 2);
+}
+
+void Rewriter::build()
+{
+    framing_.clear();
+    pieces_.clear();
+    std::stable_sort(insertions_.begin(), insertions_.end(), [](const Insertion &a, const Insertion &b) {
+        return a.position < b.position;
+    });
+
+    size_t delimiter = 2 + boundary_.size() + 2;
+    size_t k = 0;
+    for (size_t n = 0; n < parts_.size(); n++) {
+        while (k < insertions_.size() && insertions_[k].position == n) emitInsertion(insertions_[k++]);
+
+        const PartEntry &part = parts_[n];
+        if (part.dropped) {
+            continue;
+        }
+        if (part.headersEdited) {
+            emit(Piece::Original, part.begin, nullptr, delimiter);
+            emitHeaders(part.firstHeader, part.headers);
+            emit(Piece::Original, part.bodyBegin - 2, nullptr, 2); // blank line
+        }
+        else {
+            emit(Piece::Original, part.begin, nullptr, part.bodyBegin - part.begin);
+        }
+        if (part.bodyReplaced) {
+            emit(Piece::External, 0, part.body.data(), part.body.size());
+        }
+        else {
+            emit(Piece::Original, part.bodyBegin, nullptr, part.bodyEnd - part.bodyBegin);
+        }
+        emit(Piece::Original, part.bodyEnd, nullptr, 2);
+    }
+    while (k < insertions_.size()) emitInsertion(insertions_[k++]);
+
+    emit(Piece::Original, tail_, nullptr, buffer_.size() - tail_);
+}
+
+size_t Rewriter::size()
+{
+    build();
+    size_t result = 0;
+    for (const Piece &piece : pieces_) result += piece.length;
+    return result;
+}
+
+void Rewriter::encode(std::string &output)
+{
+    output.clear();
+    output.reserve(size());
+    for (const Piece &piece : pieces_) {
+        switch (piece.source) {
+        case Piece::Original:
+            output.append(buffer_.data() + piece.offset, piece.length);
+            break;
+        case Piece::Framing:
+            output.append(framing_.data() + piece.offset, piece.length);
+            break;
+        case Piece::External:
+            output.append(piece.data, piece.length);
+            break;
+        }
+    }
+}
+
+std::string Rewriter::encode()
+{
+    std::string result;
+    encode(result);
+    return result;
+}
+
+const std::vector<struct iovec> &Rewriter::iovecs()
+{
+    build(); // framing_ is complete: its buffer does not move any more
+
+    iovecs_.clear();
+    for (const Piece &piece : pieces_) {
+        const char *base = (piece.source == Piece::Original) ? buffer_.data() : (piece.source == Piece::Framing) ? framing_.data() : nullptr;
+        iovecs_.push_back(iovec{(void*)(base ? base + piece.offset : piece.data), piece.length});
+    }
+    return iovecs_;
+}
+
+}
+}
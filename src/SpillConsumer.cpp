@@ -0,0 +1,185 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <ert/multipart/SpillConsumer.hpp>
+
+
+namespace ert
+{
+namespace multipart
+{
+
+SpilledPart::SpilledPart()
+{
+    fd_ = -1;
+    size_ = 0;
+    map_ = nullptr;
+    keep_ = false;
+    failed_ = false;
+}
+
+SpilledPart::~SpilledPart()
+{
+    release();
+}
+
+void SpilledPart::release()
+{
+    if (map_) {
+        munmap(map_, size_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    if (!path_.empty() && !keep_) {
+        unlink(path_.c_str());
+    }
+    path_.clear();
+    memory_.clear(); // keeps capacity for next parts
+    size_ = 0;
+    keep_ = false;
+    failed_ = false;
+}
+
+std::string_view SpilledPart::view()
+{
+    if (fd_ < 0) {
+        return memory_;
+    }
+    if (!map_ && size_ > 0) {
+        void *map = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            return std::string_view();
+        }
+        map_ = map;
+    }
+    return std::string_view((const char*)map_, map_ ? size_ : 0);
+}
+
+SpillConsumer::SpillConsumer(const std::string& boundary) : Consumer(boundary)
+{
+    threshold_ = 1 << 20;
+    const char *tmpdir = getenv("TMPDIR");
+    directory_ = (tmpdir && *tmpdir) ? tmpdir : "/tmp";
+}
+
+SpillConsumer::~SpillConsumer()
+{
+}
+
+bool SpillConsumer::spill()
+{
+    part_.path_ = directory_ + "/multipart-XXXXXX";
+    part_.fd_ = mkstemp(&part_.path_[0]);
+    if (part_.fd_ < 0) {
+        part_.path_.clear();
+        return false;
+    }
+    return true;
+}
+
+void SpillConsumer::write(const char *data, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = ::write(part_.fd_, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            part_.failed_ = true;
+            return;
+        }
+        data += written;
+        length -= written;
+    }
+}
+
+void SpillConsumer::receiveDataView(std::string_view data)
+{
+    if (part_.failed_) {
+        return;
+    }
+
+    part_.size_ += data.size();
+    if (part_.fd_ < 0) {
+        if (part_.size_ <= threshold_) {
+            part_.memory_.append(data.data(), data.size());
+            return;
+        }
+        if (!spill()) { // memory data is written with the next buffer
+            part_.failed_ = true;
+            return;
+        }
+    }
+
+    // Buffered writes:
+    if (part_.memory_.size() + data.size() < WriteSize) {
+        part_.memory_.append(data.data(), data.size());
+        return;
+    }
+    write(part_.memory_.data(), part_.memory_.size());
+    part_.memory_.clear();
+    if (data.size() >= WriteSize) {
+        write(data.data(), data.size());
+    }
+    else {
+        part_.memory_.append(data.data(), data.size());
+    }
+}
+
+void SpillConsumer::receivePartEnd()
+{
+    if (part_.fd_ >= 0) {
+        write(part_.memory_.data(), part_.memory_.size());
+        part_.memory_.clear();
+    }
+
+    receiveSpilledPart(part_);
+    part_.release();
+}
+
+void SpillConsumer::receiveRearm()
+{
+    part_.release();
+}
+
+}
+}
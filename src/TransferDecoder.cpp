@@ -0,0 +1,376 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string.h>
+#include <strings.h>
+
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TRANSFER_DECODE_X86
+#include <immintrin.h>
+#endif
+
+#include <ert/multipart/TransferDecoder.hpp>
+
+#include "Text.hpp"
+
+
+namespace ert
+{
+namespace multipart
+{
+
+namespace {
+
+const unsigned char Invalid = 0xFF;
+const unsigned char Padding = 0xFE;
+
+struct Base64Table {
+    unsigned char value[256];
+};
+
+constexpr Base64Table makeBase64Table() {
+    Base64Table table{};
+    for (int c = 0; c < 256; c++) table.value[c] = Invalid;
+    for (int c = 'A'; c <= 'Z'; c++) table.value[c] = (unsigned char)(c - 'A');
+    for (int c = 'a'; c <= 'z'; c++) table.value[c] = (unsigned char)(c - 'a' + 26);
+    for (int c = '0'; c <= '9'; c++) table.value[c] = (unsigned char)(c - '0' + 52);
+    table.value[(int)'+'] = 62;
+    table.value[(int)'/'] = 63;
+    table.value[(int)'='] = Padding;
+    return table;
+}
+
+constexpr Base64Table Base64 = makeBase64Table();
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Block decoders: whole quanta from the beginning of the input, and CRLF line
+// breaks between them, up to the first other character outside the alphabet.
+// Return the number of characters consumed.
+typedef size_t (*base64_block_fn)(const char *in, size_t len, char *out, size_t *written);
+
+bool lineBreak(const char *in, size_t len, size_t i) {
+    return (i + 2 <= len && in[i] == '\r' && in[i + 1] == '\n');
+}
+
+size_t base64_quanta(const char *in, size_t len, char *out, size_t *written) {
+    size_t i = 0;
+    char *o = out;
+    while (i + 4 <= len) {
+        uint32_t a = Base64.value[(unsigned char)in[i]];
+        uint32_t b = Base64.value[(unsigned char)in[i + 1]];
+        uint32_t c = Base64.value[(unsigned char)in[i + 2]];
+        uint32_t d = Base64.value[(unsigned char)in[i + 3]];
+        if ((a | b | c | d) >= 64) break;
+        uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+        o[0] = (char)(bits >> 16);
+        o[1] = (char)(bits >> 8);
+        o[2] = (char)bits;
+        o += 3;
+        i += 4;
+    }
+    *written = o - out;
+    return i;
+}
+
+size_t base64_block_scalar(const char *in, size_t len, char *out, size_t *written) {
+    size_t i = 0;
+    char *o = out;
+    for (;;) {
+        size_t quanta;
+        i += base64_quanta(in + i, len - i, o, &quanta);
+        o += quanta;
+        if (!lineBreak(in, len, i)) break;
+        i += 2;
+    }
+
+    *written = o - out;
+    return i;
+}
+
+#ifdef TRANSFER_DECODE_X86
+// 32 characters are validated and translated to sextets with nibble lookups, then
+// packed to 24 bytes (stores 32: the output bound keeps room for it). A block with
+// a line break delivers the quanta before it.
+__attribute__((target("avx2")))
+size_t base64_block_avx2(const char *in, size_t len, char *out, size_t *written) {
+    const __m256i lut_lo = _mm256_setr_epi8(
+                               0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                               0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(
+                               0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                               0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(
+                                 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(
+                             2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                             2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+    size_t i = 0;
+    char *o = out;
+    for (;;) {
+        while (i + 32 <= len) {
+            __m256i str = _mm256_loadu_si256((const __m256i*)(in + i));
+            __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+            __m256i lo_nibbles = _mm256_and_si256(str, mask_2f);
+            __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+            __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+            size_t valid = 32;
+            if (!_mm256_testz_si256(lo, hi)) {
+                // Character outside the alphabet (i.e. line break): whole quanta before it
+                uint32_t invalid = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256()));
+                valid = __builtin_ctz(invalid) & ~3u;
+                if (valid == 0) break;
+            }
+            __m256i eq_2f = _mm256_cmpeq_epi8(str, mask_2f);
+            __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+            __m256i sextets = _mm256_add_epi8(str, roll);
+
+            __m256i merged = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+            __m256i bytes = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            bytes = _mm256_shuffle_epi8(bytes, pack);
+            bytes = _mm256_permutevar8x32_epi32(bytes, lanes);
+            _mm256_storeu_si256((__m256i*)o, bytes);
+
+            o += valid / 4 * 3;
+            i += valid;
+            if (valid < 32) break;
+        }
+
+        size_t quanta; // tail of the line
+        i += base64_quanta(in + i, len - i, o, &quanta);
+        o += quanta;
+        if (!lineBreak(in, len, i)) break;
+        i += 2;
+    }
+
+    *written = o - out;
+    return i;
+}
+#endif
+
+base64_block_fn base64_block_select(const char **isa) {
+#ifdef TRANSFER_DECODE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *isa = "avx2";
+        return base64_block_avx2;
+    }
+#endif
+    *isa = "scalar";
+    return base64_block_scalar;
+}
+
+// Resolved on first use
+size_t base64_block_resolve(const char *in, size_t len, char *out, size_t *written);
+std::atomic<base64_block_fn> base64_block_impl(base64_block_resolve);
+std::atomic<const char *> base64_block_isa(nullptr);
+
+size_t base64_block_resolve(const char *in, size_t len, char *out, size_t *written) {
+    const char *isa;
+    base64_block_fn fn = base64_block_select(&isa);
+    base64_block_isa.store(isa, std::memory_order_relaxed);
+    base64_block_impl.store(fn, std::memory_order_relaxed);
+    return fn(in, len, out, written);
+}
+
+}
+
+TransferEncoding transferEncoding(std::string_view value)
+{
+    value = trim(value);
+
+    if (value.size() == 6 && strncasecmp(value.data(), "base64", 6) == 0) {
+        return TransferEncoding::Base64;
+    }
+    if (value.size() == 16 && strncasecmp(value.data(), "quoted-printable", 16) == 0) {
+        return TransferEncoding::QuotedPrintable;
+    }
+    return TransferEncoding::Identity;
+}
+
+void TransferDecoder::reset(TransferEncoding encoding)
+{
+    encoding_ = encoding;
+    bits_ = 0;
+    count_ = 0;
+    padded_ = false;
+    escape_length_ = 0;
+}
+
+size_t TransferDecoder::decode(const char *data, size_t length, char *output)
+{
+    char *out = output;
+    size_t i = 0;
+
+    switch (encoding_) {
+    case TransferEncoding::Identity:
+        memcpy(out, data, length);
+        return length;
+
+    case TransferEncoding::Base64:
+        while (i < length && !padded_) {
+            if (count_ == 0) { // quantum aligned: blocks
+                size_t written;
+                i += base64_block_impl.load(std::memory_order_relaxed)(data + i, length - i, out, &written);
+                out += written;
+            }
+
+            // Up to the next quantum boundary (or the end):
+            while (i < length) {
+                unsigned char value = Base64.value[(unsigned char)data[i++]];
+                if (value < 64) {
+                    bits_ = (bits_ << 6) | value;
+                    if (++count_ == 4) {
+                        out[0] = (char)(bits_ >> 16);
+                        out[1] = (char)(bits_ >> 8);
+                        out[2] = (char)bits_;
+                        out += 3;
+                        bits_ = 0;
+                        count_ = 0;
+                        break;
+                    }
+                }
+                else if (value == Padding) {
+                    if (count_ == 2) {
+                        *out++ = (char)(bits_ >> 4);
+                    }
+                    else if (count_ == 3) {
+                        *out++ = (char)(bits_ >> 10);
+                        *out++ = (char)(bits_ >> 2);
+                    }
+                    bits_ = 0;
+                    count_ = 0;
+                    padded_ = true;
+                    break;
+                }
+                else if (count_ == 0) {
+                    break; // i.e. line break: back to blocks
+                }
+            }
+        }
+        return out - output;
+
+    case TransferEncoding::QuotedPrintable:
+        while (i < length) {
+            char c = data[i];
+
+            if (escape_length_ == 0) {
+                // Literal run up to the next escape:
+                const char *equal = (const char*)memchr(data + i, '=', length - i);
+                size_t run = equal ? (size_t)(equal - (data + i)) : length - i;
+                memcpy(out, data + i, run);
+                out += run;
+                i += run;
+                if (i < length) {
+                    escape_[0] = '=';
+                    escape_length_ = 1;
+                    i++;
+                }
+                continue;
+            }
+
+            if (escape_length_ == 1) {
+                if (c == '\n') { // soft line break (bare LF)
+                    escape_length_ = 0;
+                    i++;
+                    continue;
+                }
+                if (c == '\r' || hexValue(c) >= 0) {
+                    escape_[1] = c;
+                    escape_length_ = 2;
+                    i++;
+                    continue;
+                }
+                *out++ = '='; // malformed: literal, and the character is processed again
+                escape_length_ = 0;
+                continue;
+            }
+
+            if (escape_[1] == '\r') {
+                if (c == '\n') { // soft line break
+                    escape_length_ = 0;
+                    i++;
+                    continue;
+                }
+            }
+            else if (hexValue(c) >= 0) {
+                *out++ = (char)((hexValue(escape_[1]) << 4) | hexValue(c));
+                escape_length_ = 0;
+                i++;
+                continue;
+            }
+            *out++ = '='; // malformed: literal, and the character is processed again
+            *out++ = escape_[1];
+            escape_length_ = 0;
+        }
+        return out - output;
+    }
+
+    return 0;
+}
+
+size_t TransferDecoder::finish(char *output)
+{
+    size_t length = 0;
+    if (encoding_ == TransferEncoding::QuotedPrintable) {
+        memcpy(output, escape_, escape_length_);
+        length = escape_length_;
+    }
+    reset(encoding_);
+    return length;
+}
+
+const char *TransferDecoder::isa()
+{
+    const char *isa = base64_block_isa.load(std::memory_order_relaxed);
+    if (!isa) {
+        base64_block_select(&isa);
+    }
+    return isa;
+}
+
+}
+}
@@ -0,0 +1,177 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/Consumer.hpp>
+#include <ert/multipart/ConsumerPool.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+// Heap allocations counter (not inlined: the compiler would see mismatched malloc()/delete and new/free() pairs):
+static std::atomic<size_t> Allocations(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void *ptr, size_t) noexcept {
+    free(ptr);
+}
+
+
+namespace {
+
+class ViewConsumer : public Consumer {
+public:
+    size_t bytes = 0;
+    ViewConsumer(const std::string &boundary) : Consumer(boundary) {;}
+    void receiveHeaderView(std::string_view name, std::string_view value) override {
+        bytes += name.size() + value.size();
+    }
+    void receiveDataView(std::string_view data) override {
+        bytes += data.size();
+    }
+};
+
+class StaticConsumer : public BasicConsumer<StaticConsumer> {
+public:
+    size_t bytes = 0;
+    StaticConsumer(const std::string &boundary) : BasicConsumer(boundary) {;}
+    void receiveHeaderView(std::string_view name, std::string_view value) {
+        bytes += name.size() + value.size();
+    }
+    void receiveDataView(std::string_view data) {
+        bytes += data.size();
+    }
+};
+
+// Address space used by the process
+size_t addressSpace() {
+    size_t pages = 0;
+    if (FILE *statm = fopen("/proc/self/statm", "r")) {
+        if (fscanf(statm, "%zu", &pages) != 1) pages = 0;
+        fclose(statm);
+    }
+    return pages * sysconf(_SC_PAGESIZE);
+}
+
+// Boundary whose parser storage cannot be allocated, once the address space is limited
+// (in a death test child process): 0 if the consumer reports it and stays failed
+int boundaryNotArmed() {
+    std::string body = "--B\r\n\r\ndata\r\n--B--";
+    StaticConsumer consumer("B");
+    std::string boundary(64 << 20, 'b');
+    rlimit limit { addressSpace() + (16 << 20), RLIM_INFINITY };
+    setrlimit(RLIMIT_AS, &limit);
+
+    bool armed = consumer.reset(boundary);
+    bool failed = !consumer.feed(body.data(), body.size()) && consumer.result().status == DecodeStatus::Malformed;
+    consumer.rewind();
+    bool stillFailed = !consumer.feed(body.data(), body.size());
+    bool rearmed = consumer.reset("B") && consumer.feed(body.data(), body.size()) && consumer.finish();
+    return (!armed && failed && stillFailed && rearmed) ? 0 : 1;
+}
+
+std::vector<std::string> bodies(const std::string &boundary) {
+    std::mt19937 rng(31);
+    std::vector<std::string> result;
+    for (int n = 0; n < 50; n++) result.push_back(randomBody(rng, boundary, 1 + rng() % 8, 500));
+    return result;
+}
+
+}
+
+TEST(Allocations, PooledConsumer) {
+    std::string boundary = "7MA4YWxkTrZu0gW";
+    std::vector<std::string> corpus = bodies(boundary);
+    auto decode = [&]() {
+        for (const std::string &body : corpus) {
+            for (size_t chunk : { size_t(0), size_t(7) }) {
+                auto consumer = ConsumerPool<ViewConsumer>::acquire(boundary);
+                EXPECT_TRUE(decodeChunked(*consumer, body, chunk));
+            }
+        }
+    };
+
+    decode(); // warm up
+    size_t before = Allocations.load(std::memory_order_relaxed);
+    decode();
+    EXPECT_EQ(Allocations.load(std::memory_order_relaxed) - before, 0u);
+}
+
+TEST(Allocations, RearmedConsumer) {
+    std::string boundary = "rearmed";
+    std::vector<std::string> corpus = bodies(boundary);
+    StaticConsumer consumer(boundary);
+    auto decode = [&]() {
+        for (const std::string &body : corpus) {
+            for (size_t chunk : { size_t(0), size_t(1), size_t(13) }) {
+                consumer.rewind();
+                EXPECT_TRUE(decodeChunked(consumer, body, chunk));
+                consumer.reset(boundary);
+                EXPECT_TRUE(decodeChunked(consumer, body, chunk));
+            }
+        }
+    };
+
+    decode(); // warm up
+    size_t before = Allocations.load(std::memory_order_relaxed);
+    decode();
+    EXPECT_EQ(Allocations.load(std::memory_order_relaxed) - before, 0u);
+}
+
+TEST(AllocationsDeathTest, BoundaryNotArmed) {
+    EXPECT_EXIT(exit(boundaryNotArmed()), ::testing::ExitedWithCode(0), "");
+}
@@ -0,0 +1,186 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ert/multipart/BasicConsumer.hpp>
+#include <ert/multipart/Parser.hpp>
+
+
+/**
+* Random well-formed body: parts with some well-known headers and binary data full
+* of CR, LF, hyphens and delimiter prefixes (never the whole delimiter)
+*/
+inline std::string randomData(std::mt19937 &rng, size_t length, const std::string &boundary) {
+    static const char pool[] = "\r\n-ab";
+    std::string result;
+    while (result.size() < length) {
+        unsigned kind = rng() % 20;
+        if (kind < 6) result += pool[rng() % 5];
+        else if (kind == 6) result += "\r\n--" + boundary.substr(0, rng() % (boundary.size() + 1));
+        else result += (char)(rng() % 256);
+    }
+    result.resize(length);
+    std::string delimiter = "\r\n--" + boundary;
+    for (size_t pos; (pos = result.find(delimiter)) != std::string::npos;) result[pos + 2] = 'x';
+    return result;
+}
+
+inline std::string randomBody(std::mt19937 &rng, const std::string &boundary, size_t parts, size_t maxPartSize) {
+    std::string result;
+    for (size_t n = 0; n < parts; n++) {
+        result += "--" + boundary + "\r\n";
+        size_t headers = rng() % 4;
+        if (headers > 0) result += "Content-Type: application/octet-stream\r\n";
+        if (headers > 1) result += "Content-ID: <id" + std::to_string(n) + ">\r\n";
+        if (headers > 2) result += "Content-Disposition: form-data; name=\"field\"\r\n";
+        result += "\r\n" + randomData(rng, maxPartSize ? rng() % maxPartSize : 0, boundary) + "\r\n";
+    }
+    return result + "--" + boundary + "--";
+}
+
+/**
+* Consumer recording what it receives, with the data of each part concatenated
+* (so that recordings do not depend on how the body is chunked)
+*/
+class Recorder : public ert::multipart::BasicConsumer<Recorder> {
+public:
+    std::string events;
+    size_t level; // added to the nesting level recorded
+    Recorder(const std::string &boundary, size_t level = 0) : BasicConsumer(boundary), level(level) {;}
+    void receiveHeaderView(std::string_view name, std::string_view value) {
+        events += "[H" + std::to_string(level + depth()) + ":";
+        events.append(name.data(), name.size()).append("=").append(value.data(), value.size()).append("]");
+    }
+    void receiveDataView(std::string_view data) {
+        events.append(data.data(), data.size());
+    }
+    void receivePartEnd() {
+        events += "[E" + std::to_string(level + depth()) + "]";
+    }
+};
+
+/**
+* Decodes a body in chunks of the given size (whole body when 0)
+*
+* @return finish() result
+*/
+template <class T>
+bool decodeChunked(T &consumer, std::string_view body, size_t chunk) {
+    if (chunk == 0) chunk = body.size() ? body.size() : 1;
+    for (size_t offset = 0; offset < body.size(); offset += chunk) {
+        consumer.feed(body.data() + offset, std::min(chunk, body.size() - offset));
+    }
+    return consumer.finish();
+}
+
+/**
+* Parser hooks trace, merging the fragments of a field, value or data (which depend
+* on the chunks and on the matcher scanning part data)
+*/
+struct Trace : ert::multipart::ParserHandler {
+    std::string events;
+    char last = 0;
+
+    int fragment(char tag, const char *at, size_t length) {
+        if (tag != last) {
+            events += '|';
+            events += tag;
+            last = tag;
+        }
+        events.append(at, length);
+        return 0;
+    }
+    int notify(char tag) {
+        events += '|';
+        events += tag;
+        last = tag;
+        return 0;
+    }
+    int onPartDataBegin() {
+        return notify('B');
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return fragment('F', at, length);
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return fragment('V', at, length);
+    }
+    int onHeadersComplete() {
+        return notify('C');
+    }
+    int onPartData(const char *at, size_t length) {
+        return length ? fragment('D', at, length) : 0;
+    }
+    int onPartDataEnd() {
+        return notify('E');
+    }
+    int onBodyEnd() {
+        return notify('Z');
+    }
+};
+
+/**
+* Parses a body in chunks split at the given points, tracing the parser hooks
+*
+* @param execute Parser execution, called as execute(parser, trace, data, length)
+*
+* @return trace, followed by the error offset or the completion
+*/
+template <class Execute>
+std::string traceChunked(const std::string &boundary, ert::multipart::multipart_matcher matcher, const std::string &body, const std::vector<size_t> &splits, Execute execute) {
+    ert::multipart::multipart_parser parser;
+    ert::multipart::multipart_parser_construct(&parser, boundary.c_str(), nullptr);
+    ert::multipart::multipart_parser_set_matcher(&parser, matcher);
+    Trace trace;
+    size_t offset = 0;
+    for (size_t n = 0; n <= splits.size(); n++) {
+        size_t end = (n < splits.size()) ? splits[n] : body.size();
+        size_t parsed = execute(&parser, trace, body.data() + offset, end - offset);
+        if (parsed != end - offset) {
+            trace.events += "|!" + std::to_string(offset + parsed);
+            break;
+        }
+        offset = end;
+    }
+    if (ert::multipart::multipart_parser_completed(&parser)) trace.events += "|completed";
+    ert::multipart::multipart_parser_destroy(&parser);
+    return trace.events;
+}
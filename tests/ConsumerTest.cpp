@@ -0,0 +1,198 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/Consumer.hpp>
+#include <ert/multipart/Metrics.hpp>
+#include <ert/multipart/MultipartView.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+// Delivers whole parts only (coalesced parts mode)
+class PartRecorder : public BasicConsumer<PartRecorder> {
+public:
+    std::vector<std::string> parts;
+    PartRecorder(const std::string &boundary) : BasicConsumer(boundary) {
+        setCoalescedParts(true);
+    }
+    void receivePartView(std::string_view data) {
+        parts.emplace_back(data);
+    }
+};
+
+// Skips parts without Content-ID
+class FilterRecorder : public BasicConsumer<FilterRecorder> {
+public:
+    std::vector<std::string> parts;
+    bool identified = false;
+    FilterRecorder(const std::string &boundary) : BasicConsumer(boundary) {;}
+    void receiveHeaderIdView(HeaderId id, std::string_view name, std::string_view value) {
+        if (id == HeaderId::ContentId) identified = true;
+    }
+    bool acceptPart() {
+        bool result = identified;
+        identified = false;
+        if (result) parts.emplace_back();
+        return result;
+    }
+    void receiveDataView(std::string_view data) {
+        parts.back().append(data.data(), data.size());
+    }
+};
+
+}
+
+TEST(Consumer, ChunkSplitEquivalence) {
+    std::mt19937 rng(2022);
+    for (int iteration = 0; iteration < 300; iteration++) {
+        std::string boundary = std::string("7MA4YWxkTrZu0gW").substr(0, 1 + rng() % 15);
+        std::string body = randomBody(rng, boundary, 1 + rng() % 6, 200);
+        if (iteration % 5 == 1) body.resize(rng() % body.size()); // incomplete
+        if (iteration % 5 == 2) body[rng() % body.size()] = "\r\n-:"[rng() % 4]; // maybe malformed
+
+        Recorder whole(boundary);
+        bool completed = decodeChunked(whole, body, 0);
+
+        for (size_t chunk : { (size_t)1, (size_t)2, (size_t)3, (size_t)7, (size_t)64, (size_t)(1 + rng() % 100) }) {
+            Recorder chunked(boundary);
+            EXPECT_EQ(decodeChunked(chunked, body, chunk), completed);
+            EXPECT_EQ(chunked.events, whole.events) << "chunk " << chunk << ", iteration " << iteration;
+            EXPECT_EQ(chunked.offset(), whole.offset());
+        }
+
+        // Every split point in two chunks, reusing the consumer:
+        Recorder split(boundary);
+        for (size_t point = 0; point <= body.size(); point += 1 + body.size() / 64) {
+            split.reset(boundary);
+            split.events.clear();
+            split.feed(body.data(), point);
+            split.feed(body.data() + point, body.size() - point);
+            EXPECT_EQ(split.finish(), completed);
+            EXPECT_EQ(split.events, whole.events) << "split at " << point;
+        }
+    }
+}
+
+TEST(Consumer, CoalescedPartsMatchFragments) {
+    std::mt19937 rng(9);
+    for (int iteration = 0; iteration < 200; iteration++) {
+        std::string boundary = "b" + std::to_string(iteration);
+        std::string body = randomBody(rng, boundary, 1 + rng() % 6, 300);
+
+        std::vector<std::string> expected;
+        for (const Part &part : MultipartView(body, boundary)) expected.emplace_back(part.body);
+
+        for (size_t chunk : { (size_t)0, (size_t)1, (size_t)5, (size_t)(1 + rng() % 200) }) {
+            PartRecorder consumer(boundary);
+            EXPECT_TRUE(decodeChunked(consumer, body, chunk));
+            EXPECT_EQ(consumer.parts, expected) << "chunk " << chunk;
+        }
+    }
+}
+
+TEST(Consumer, PartFilterSkipsData) {
+    std::mt19937 rng(14);
+    for (int iteration = 0; iteration < 200; iteration++) {
+        std::string boundary = "filter";
+        std::string body = randomBody(rng, boundary, 1 + rng() % 8, 100);
+
+        std::vector<std::string> expected;
+        for (const Part &part : MultipartView(body, boundary)) {
+            if (!part.header(HeaderId::ContentId).empty()) expected.emplace_back(part.body);
+        }
+
+        for (size_t chunk : { (size_t)0, (size_t)3 }) {
+            FilterRecorder consumer(boundary);
+            EXPECT_TRUE(decodeChunked(consumer, body, chunk));
+            EXPECT_EQ(consumer.parts, expected);
+        }
+    }
+}
+
+TEST(Consumer, NestedParts) {
+    std::mt19937 rng(16);
+    for (int iteration = 0; iteration < 100; iteration++) {
+        std::string inner = randomBody(rng, "inner", 1 + rng() % 3, 50);
+        std::string body = "--outer\r\nContent-Type: text/plain\r\n\r\nfirst\r\n"
+                           "--outer\r\nContent-Type: multipart/mixed; boundary=inner\r\n\r\n" + inner + "\r\n"
+                           "--outer--";
+
+        // Expected: outer part, then inner parts at depth 1 (the part holding them has no end)
+        Recorder reference("inner", 1);
+        ASSERT_TRUE(decodeChunked(reference, inner, 0));
+        std::string expected = "[H0:Content-Type=text/plain]first[E0][H0:Content-Type=multipart/mixed; boundary=inner]" + reference.events;
+
+        for (size_t chunk : { (size_t)0, (size_t)1, (size_t)(1 + rng() % 64) }) {
+            Recorder consumer("outer");
+            consumer.setMaxDepth(1);
+            EXPECT_TRUE(decodeChunked(consumer, body, chunk));
+            EXPECT_EQ(consumer.events, expected) << "chunk " << chunk;
+        }
+
+        // Not decoded beyond the maximum depth:
+        Recorder flat("outer");
+        EXPECT_TRUE(decodeChunked(flat, body, 0));
+        EXPECT_NE(flat.events.find(inner), std::string::npos);
+    }
+}
+
+#if ERT_MULTIPART_METRICS
+TEST(Consumer, DecodeRecordsMetrics) {
+    std::mt19937 rng(20);
+    std::string body = randomBody(rng, "metrics", 3, 100);
+    Metrics metrics;
+    Consumer consumer("metrics");
+    consumer.setMetrics(&metrics);
+
+    for (int decodes = 1; decodes <= 3; decodes++) {
+        consumer.rewind();
+        EXPECT_EQ(consumer.decode(body).status, DecodeStatus::Complete);
+        EXPECT_EQ(metrics.value(Metrics::Decodes), (uint64_t)decodes);
+        EXPECT_EQ(metrics.value(Metrics::Parts), (uint64_t)(3 * decodes));
+        EXPECT_EQ(metrics.value(Metrics::Bytes), (uint64_t)(body.size() * decodes));
+        EXPECT_EQ(metrics.latency().count(), (uint64_t)decodes);
+    }
+}
+#endif
@@ -0,0 +1,217 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/Consumer.hpp>
+#include <ert/multipart/ParallelDecoder.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+class Counter : public BasicConsumer<Counter> {
+public:
+    size_t data = 0;
+    size_t parts = 0;
+    Counter() : BasicConsumer("B") {;}
+    void receiveDataView(std::string_view view) {
+        data += view.size();
+    }
+    void receivePartEnd() {
+        parts++;
+    }
+};
+
+std::string part(const std::string &header, const std::string &data) {
+    return "--B\r\n" + header + "\r\n\r\n" + data + "\r\n";
+}
+
+const std::string Body = part("Content-Type: a", "hello") + part("X: 1", "world!") + part("Y: 2", "z") + "--B--";
+
+DecodeResult decode(const std::string &body, DecodeLimits limits, Counter &consumer) {
+    consumer.setLimits(limits);
+    consumer.feed(body.data(), body.size());
+    return consumer.result();
+}
+
+}
+
+TEST(DecodeLimits, CompleteAndIncomplete) {
+    Counter complete;
+    DecodeResult result = decode(Body, DecodeLimits(), complete);
+    EXPECT_EQ(result.status, DecodeStatus::Complete);
+    EXPECT_EQ(result.offset, Body.size());
+
+    Counter incomplete;
+    incomplete.feed(Body.data(), 10);
+    EXPECT_EQ(incomplete.result().status, DecodeStatus::Incomplete);
+    EXPECT_TRUE(incomplete.result().ok());
+}
+
+TEST(DecodeLimits, MalformedOffset) {
+    std::string body = "--B\r\nX";
+    body += '\0';
+    body += "junk";
+    Counter consumer;
+    consumer.feed(body.data(), body.size());
+    DecodeResult result = consumer.result();
+    EXPECT_EQ(result.status, DecodeStatus::Malformed);
+    EXPECT_EQ(result.offset, body.find('\0'));
+    EXPECT_FALSE(result.ok());
+}
+
+TEST(DecodeLimits, Parts) {
+    Counter consumer;
+    DecodeLimits limits;
+    limits.parts = 2;
+    DecodeResult result = decode(Body, limits, consumer);
+    EXPECT_EQ(result.status, DecodeStatus::TooManyParts);
+    EXPECT_EQ(consumer.parts, 2u);
+    EXPECT_LE(result.offset, Body.find("--B\r\nY") + 5);
+}
+
+TEST(DecodeLimits, PartAndHeaderSize) {
+    DecodeLimits limits;
+    limits.partSize = 5;
+    Counter part;
+    EXPECT_EQ(decode(Body, limits, part).status, DecodeStatus::PartTooLarge);
+    EXPECT_EQ(part.parts, 1u);
+    EXPECT_EQ(part.data, 5u);
+
+    limits = DecodeLimits();
+    limits.headerBytes = 5;
+    Counter header;
+    EXPECT_EQ(decode(Body, limits, header).status, DecodeStatus::HeaderTooLarge);
+    EXPECT_EQ(header.parts, 0u);
+
+    limits.headerBytes = 13;
+    Counter fits;
+    EXPECT_EQ(decode(Body, limits, fits).status, DecodeStatus::Complete);
+}
+
+TEST(DecodeLimits, BodySizeAcrossChunks) {
+    for (size_t limit : { size_t(0), size_t(7), size_t(30), Body.size() - 1, Body.size() }) {
+        for (size_t step : { size_t(1), size_t(3), Body.size() }) {
+            Counter consumer;
+            DecodeLimits limits;
+            limits.bodySize = limit;
+            consumer.setLimits(limits);
+            for (size_t offset = 0; offset < Body.size(); offset += step) {
+                consumer.feed(Body.data() + offset, std::min(step, Body.size() - offset));
+            }
+            DecodeResult result = consumer.result();
+            if (limit < Body.size()) {
+                EXPECT_EQ(result.status, DecodeStatus::BodyTooLarge);
+                EXPECT_EQ(result.offset, limit);
+            }
+            else {
+                EXPECT_EQ(result.status, DecodeStatus::Complete);
+            }
+            consumer.rewind();
+            EXPECT_TRUE(consumer.feed(Body.data(), std::min(limit, Body.size())));
+        }
+    }
+}
+
+TEST(DecodeLimits, Depth) {
+    std::string inner = "--I\r\nA: b\r\n\r\nx\r\n--I--";
+    std::string body = part("Content-Type: multipart/mixed; boundary=I", inner) + "--B--";
+    DecodeLimits limits;
+
+    Counter nested;
+    nested.setMaxDepth(2);
+    EXPECT_EQ(decode(body, limits, nested).status, DecodeStatus::Complete);
+
+    limits.depth = 0;
+    Counter tooDeep;
+    tooDeep.setMaxDepth(2);
+    EXPECT_EQ(decode(body, limits, tooDeep).status, DecodeStatus::TooDeep);
+
+    Counter flat; // nested body delivered as data
+    EXPECT_EQ(decode(body, limits, flat).status, DecodeStatus::Complete);
+
+    limits = DecodeLimits();
+    limits.parts = 1;
+    Counter parts;
+    parts.setMaxDepth(2);
+    EXPECT_EQ(decode(body, limits, parts).status, DecodeStatus::TooManyParts);
+}
+
+TEST(DecodeLimits, Consumer) {
+    Consumer consumer("B");
+    EXPECT_EQ(consumer.decode(Body).status, DecodeStatus::Complete);
+    DecodeLimits limits;
+    limits.partSize = 3;
+    consumer.reset("B");
+    consumer.setLimits(limits);
+    EXPECT_EQ(consumer.decode(Body).status, DecodeStatus::PartTooLarge);
+    consumer.rewind();
+    EXPECT_EQ(consumer.limits().partSize, 3u);
+}
+
+TEST(DecodeLimits, ParallelDecoder) {
+    std::string body;
+    for (int n = 0; n < 200; n++) body += part("X: " + std::to_string(n), std::string(1000, 'a' + n % 26));
+    body += "--B--";
+    ParallelDecoder decoder(2);
+    DecodeLimits limits;
+
+    Counter complete;
+    EXPECT_TRUE(decoder.decode(complete, body.data(), body.size()));
+    EXPECT_EQ(complete.result().status, DecodeStatus::Complete);
+
+    limits.parts = 50;
+    Counter parts;
+    parts.setLimits(limits);
+    EXPECT_FALSE(decoder.decode(parts, body.data(), body.size()));
+    EXPECT_EQ(parts.result().status, DecodeStatus::TooManyParts);
+    EXPECT_EQ(parts.parts, 50u);
+    Counter serial;
+    serial.setLimits(limits);
+    serial.feed(body.data(), body.size());
+    EXPECT_EQ(parts.result().offset, serial.result().offset);
+
+    limits = DecodeLimits();
+    limits.bodySize = 5000;
+    Counter size;
+    size.setLimits(limits);
+    EXPECT_FALSE(decoder.decode(size, body.data(), body.size()));
+    EXPECT_EQ(size.result().status, DecodeStatus::BodyTooLarge);
+    EXPECT_EQ(size.result().offset, 5000u);
+}
@@ -0,0 +1,236 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/DecoderEngine.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+// Stream results, as delivered by the close handler (on the shard threads)
+struct Closed {
+    std::mutex mutex;
+    std::map<uint64_t, std::pair<std::string, bool>> streams;
+    std::atomic<size_t> opened{0};
+
+    void attach(DecoderEngine<Recorder> &engine, std::chrono::microseconds delay = std::chrono::microseconds(0)) {
+        engine.setOpenHandler([this](uint64_t stream, Recorder &consumer) {
+            consumer.events.clear(); // pooled consumers keep their recording
+            opened++;
+        });
+        engine.setCloseHandler([this, delay](uint64_t stream, Recorder &consumer, bool complete) {
+            if (delay.count()) std::this_thread::sleep_for(delay); // shard busy
+            std::lock_guard<std::mutex> lock(mutex);
+            EXPECT_EQ(streams.count(stream), 0) << "stream " << stream << " closed twice";
+            streams[stream] = { consumer.events, complete };
+        });
+    }
+};
+
+struct Stream {
+    uint64_t id;
+    std::string boundary;
+    std::string body;
+    size_t offset;
+    std::string events; // reference decoding
+    bool complete;
+};
+
+std::vector<Stream> streams(std::mt19937 &rng, size_t count, size_t maxPartSize) {
+    std::vector<Stream> result;
+    for (size_t k = 0; k < count; k++) {
+        Stream stream{ 2 * k + 1, "stream" + std::to_string(k % 7), "", 0, "", false };
+        stream.body = randomBody(rng, stream.boundary, 1 + rng() % 4, maxPartSize);
+        if (k % 5 == 4) stream.body.resize(rng() % stream.body.size()); // incomplete
+        Recorder reference(stream.boundary);
+        stream.complete = decodeChunked(reference, stream.body, 0);
+        stream.events = reference.events;
+        result.push_back(std::move(stream));
+    }
+    return result;
+}
+
+// Opens every stream, submits their chunks interleaved at random, and closes each after its last chunk
+void interleave(DecoderEngine<Recorder> &engine, std::vector<Stream> &streams, std::mt19937 &rng, size_t maxChunk, bool close = true) {
+    std::vector<size_t> pending;
+    for (size_t k = 0; k < streams.size(); k++) {
+        engine.open(streams[k].id, streams[k].boundary);
+        pending.push_back(k);
+    }
+    while (!pending.empty()) {
+        size_t pick = rng() % pending.size();
+        Stream &stream = streams[pending[pick]];
+        size_t length = std::min(1 + rng() % maxChunk, stream.body.size() - stream.offset);
+        engine.submit(stream.id, stream.body.data() + stream.offset, length);
+        stream.offset += length;
+        if (stream.offset == stream.body.size()) {
+            if (close) engine.close(stream.id);
+            pending[pick] = pending.back();
+            pending.pop_back();
+        }
+    }
+}
+
+}
+
+TEST(DecoderEngine, ManyStreamsAcrossShards) {
+    std::mt19937 rng(21);
+    std::vector<Stream> all = streams(rng, 300, 400);
+
+    DecoderEngine<Recorder> engine(4, 16); // small queues: producer waits for room
+    Closed closed;
+    closed.attach(engine);
+    EXPECT_EQ(engine.shards(), 4);
+
+    interleave(engine, all, rng, 64);
+    engine.flush();
+
+    EXPECT_EQ(closed.opened, all.size());
+    ASSERT_EQ(closed.streams.size(), all.size());
+    for (const Stream &stream : all) {
+        EXPECT_EQ(closed.streams[stream.id].first, stream.events) << "stream " << stream.id;
+        EXPECT_EQ(closed.streams[stream.id].second, stream.complete) << "stream " << stream.id;
+    }
+}
+
+TEST(DecoderEngine, ReusedStreams) {
+    std::mt19937 rng(210);
+    DecoderEngine<Recorder> engine(2, 64);
+    Closed closed;
+    closed.attach(engine);
+
+    // Same identifiers over and over (reused table entries and pooled consumers):
+    for (int round = 0; round < 20; round++) {
+        std::vector<Stream> all = streams(rng, 40, 100);
+        interleave(engine, all, rng, 32);
+        engine.flush();
+        ASSERT_EQ(closed.streams.size(), all.size());
+        for (const Stream &stream : all) {
+            EXPECT_EQ(closed.streams[stream.id].first, stream.events) << "round " << round;
+        }
+        closed.streams.clear();
+    }
+
+    // Open restarts a stream, chunks of unknown streams are ignored:
+    std::string body = "--b\r\n\r\nfirst\r\n--b--";
+    engine.open(1, "b");
+    engine.submit(1, body.data(), 10);
+    engine.open(1, "b");
+    engine.submit(1, body.data(), body.size());
+    engine.submit(3, body.data(), body.size());
+    engine.close(1);
+    engine.close(3);
+    engine.flush();
+    ASSERT_EQ(closed.streams.size(), 1);
+    EXPECT_EQ(closed.streams[1].first, "first[E0]");
+    EXPECT_TRUE(closed.streams[1].second);
+}
+
+TEST(DecoderEngine, CloseWhileShardBusy) {
+    std::mt19937 rng(2100);
+    std::vector<Stream> all = streams(rng, 60, 200);
+
+    DecoderEngine<Recorder> engine(2, 4);
+    Closed closed;
+    closed.attach(engine, std::chrono::microseconds(500));
+
+    interleave(engine, all, rng, 100);
+    engine.flush();
+
+    ASSERT_EQ(closed.streams.size(), all.size());
+    for (const Stream &stream : all) {
+        EXPECT_EQ(closed.streams[stream.id].first, stream.events);
+        EXPECT_EQ(closed.streams[stream.id].second, stream.complete);
+    }
+}
+
+TEST(DecoderEngine, WakesSleepingShards) {
+    std::mt19937 rng(21000);
+    DecoderEngine<Recorder> engine(3, 8);
+    Closed closed;
+    closed.attach(engine);
+
+    for (int round = 0; round < 10; round++) {
+        std::vector<Stream> all = streams(rng, 3, 50);
+        for (Stream &stream : all) stream.id += 100 * round;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // shards go to sleep
+        interleave(engine, all, rng, 1000);
+        engine.flush();
+        for (const Stream &stream : all) {
+            EXPECT_EQ(closed.streams[stream.id].first, stream.events);
+        }
+    }
+    EXPECT_EQ(closed.streams.size(), 30);
+}
+
+TEST(DecoderEngine, ShutdownWithPendingWork) {
+    std::mt19937 rng(210000);
+    std::vector<Stream> all = streams(rng, 100, 200);
+    std::vector<Stream> open = streams(rng, 20, 200);
+    for (Stream &stream : open) stream.id += 1000;
+
+    Closed closed;
+    {
+        DecoderEngine<Recorder> engine(4, 32);
+        closed.attach(engine, std::chrono::microseconds(200));
+        interleave(engine, all, rng, 50);
+        interleave(engine, open, rng, 50, false);
+        // Destroyed with queued events, and streams left open
+    }
+
+    // Queued events processed, streams left open discarded:
+    EXPECT_EQ(closed.opened, all.size() + open.size());
+    ASSERT_EQ(closed.streams.size(), all.size());
+    for (const Stream &stream : all) {
+        EXPECT_EQ(closed.streams[stream.id].first, stream.events);
+        EXPECT_EQ(closed.streams[stream.id].second, stream.complete);
+    }
+}
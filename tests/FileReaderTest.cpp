@@ -0,0 +1,178 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <random>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/FileReader.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+// Temporary file with the given content, removed on destruction
+class TemporaryFile {
+public:
+    std::string path;
+    TemporaryFile(const std::string &content) {
+        char name[] = "/tmp/file-reader-test-XXXXXX";
+        int fd = mkstemp(name);
+        path = name;
+        EXPECT_EQ(write(fd, content.data(), content.size()), (ssize_t)content.size());
+        close(fd);
+    }
+    ~TemporaryFile() {
+        unlink(path.c_str());
+    }
+};
+
+std::string reference(const std::string &boundary, const std::string &body) {
+    Recorder consumer(boundary);
+    decodeChunked(consumer, body, 0);
+    return consumer.events;
+}
+
+}
+
+TEST(FileReader, RegularFileMapped) {
+    std::mt19937 rng(19);
+    std::string body = randomBody(rng, "file", 8, 20000);
+    TemporaryFile file(body);
+
+    // Given at once:
+    size_t calls = 0;
+    std::string content;
+    EXPECT_TRUE(readFile(file.path, [&](const char *data, size_t length) {
+        calls++;
+        content.append(data, length);
+        return true;
+    }));
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(content, body);
+
+    Recorder consumer("file");
+    EXPECT_TRUE(consumer.decodeFile(file.path));
+    EXPECT_TRUE(consumer.finish());
+    EXPECT_EQ(consumer.events, reference("file", body));
+}
+
+TEST(FileReader, PipeStreamed) {
+    std::mt19937 rng(190);
+    std::string body = randomBody(rng, "pipe", 8, 50000); // beyond the pipe buffer;
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::thread writer([&]() {
+        for (size_t offset = 0; offset < body.size();) {
+            ssize_t written = write(fds[1], body.data() + offset, std::min((size_t)4096, body.size() - offset));
+            if (written <= 0) break;
+            offset += written;
+        }
+        close(fds[1]);
+    });
+
+    Recorder consumer("pipe");
+    EXPECT_TRUE(consumer.decodeFd(fds[0]));
+    writer.join();
+    close(fds[0]);
+    EXPECT_TRUE(consumer.finish());
+    EXPECT_EQ(consumer.events, reference("pipe", body));
+}
+
+TEST(FileReader, FromCurrentOffset) {
+    std::mt19937 rng(1900);
+    std::string body = randomBody(rng, "offset", 4, 1000);
+    for (size_t skip : { (size_t)1, (size_t)4095, (size_t)4096, (size_t)10000 }) {
+        TemporaryFile file(std::string(skip, 'x') + body);
+        int fd = open(file.path.c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(lseek(fd, skip, SEEK_SET), (off_t)skip);
+
+        Recorder consumer("offset");
+        EXPECT_TRUE(consumer.decodeFd(fd));
+        EXPECT_TRUE(consumer.finish()) << "skip " << skip;
+        EXPECT_EQ(consumer.events, reference("offset", body));
+        EXPECT_EQ(lseek(fd, 0, SEEK_CUR), (off_t)(skip + body.size())); // consumed
+
+        // Nothing left:
+        size_t calls = 0;
+        EXPECT_TRUE(readFd(fd, [&](const char *data, size_t length) {
+            calls++;
+            return true;
+        }));
+        EXPECT_EQ(calls, 0);
+        close(fd);
+    }
+}
+
+TEST(FileReader, EmptyFile) {
+    TemporaryFile file("");
+    size_t calls = 0;
+    EXPECT_TRUE(readFile(file.path, [&](const char *data, size_t length) {
+        calls++;
+        return true;
+    }));
+    EXPECT_EQ(calls, 0);
+
+    Recorder consumer("empty");
+    EXPECT_TRUE(consumer.decodeFile(file.path));
+    EXPECT_FALSE(consumer.finish()); // no body
+    EXPECT_TRUE(consumer.events.empty());
+}
+
+TEST(FileReader, Failures) {
+    Recorder consumer("missing");
+    EXPECT_FALSE(consumer.decodeFile("/nonexistent/multipart-body"));
+    EXPECT_FALSE(consumer.decodeFd(-1));
+    EXPECT_FALSE(readFile("/nonexistent/multipart-body", [](const char *data, size_t length) {
+        return true;
+    }));
+
+    // Stopped by the sink, and malformed body:
+    TemporaryFile file("garbage");
+    EXPECT_FALSE(readFile(file.path, [](const char *data, size_t length) {
+        return false;
+    }));
+    EXPECT_FALSE(consumer.decodeFile(file.path));
+}
@@ -0,0 +1,137 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/FixedBoundary.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+constexpr char Short[] = "q";
+constexpr char Lane[] = "7MA4YWxkTrZu0gW";
+constexpr char Repeated[] = "abababc";
+constexpr char Wide[] = "0123456789abcdefghijklmnopqrstu"; // delimiter over a 32 bytes lane
+constexpr char Longest[] = "----------------------------------------------------------------------";
+
+std::string runtime(const std::string &boundary, multipart_matcher matcher, const std::string &body, const std::vector<size_t> &splits) {
+    return traceChunked(boundary, matcher, body, splits, [](multipart_parser *parser, Trace &trace, const char *data, size_t length) {
+        return multipart_parser_execute(parser, trace, data, length);
+    });
+}
+
+template <const char *Boundary>
+std::string fixed(multipart_matcher matcher, const std::string &body, const std::vector<size_t> &splits) {
+    return traceChunked(Boundary, matcher, body, splits, [](multipart_parser *parser, Trace &trace, const char *data, size_t length) {
+        return multipart_parser_execute_fixed<Boundary>(parser, trace, data, length);
+    });
+}
+
+std::vector<std::string> bodies(const std::string &boundary, std::mt19937 &rng) {
+    std::vector<std::string> result;
+    auto part = [&](const std::string &data) {
+        return "--" + boundary + "\r\nContent-Type: a\r\n\r\n" + data + "\r\n";
+    };
+
+    // Delimiters at every position of 16 and 32 bytes lanes:
+    for (size_t offset = 0; offset < 40; offset++) {
+        result.push_back(part(std::string(offset, 'x')) + part("y") + "--" + boundary + "--");
+    }
+
+    // Delimiter prefixes repeated within part data:
+    std::string data;
+    for (size_t k = 0; k < boundary.size(); k++) data += "\r\n--" + boundary.substr(0, k) + "\r";
+    result.push_back(part(data) + part(data + data) + "--" + boundary + "--");
+
+    // Random bodies, some truncated or malformed:
+    for (int n = 0; n < 12; n++) {
+        std::string body = randomBody(rng, boundary, 1 + rng() % 4, 150);
+        if (n % 4 == 1) body.resize(rng() % body.size());
+        if (n % 4 == 2) body[rng() % body.size()] = "\r\n-:"[rng() % 4];
+        result.push_back(body);
+    }
+    return result;
+}
+
+template <const char *Boundary>
+void compareAtEverySplit() {
+    std::mt19937 rng(25);
+    for (const std::string &body : bodies(Boundary, rng)) {
+        for (multipart_matcher matcher : { MULTIPART_MATCHER_BYTE, MULTIPART_MATCHER_SIMD, MULTIPART_MATCHER_HORSPOOL }) {
+            EXPECT_EQ(fixed<Boundary>(matcher, body, {}), runtime(Boundary, matcher, body, {}));
+            for (size_t split = 0; split <= body.size(); split++) {
+                ASSERT_EQ(fixed<Boundary>(matcher, body, { split }), runtime(Boundary, matcher, body, { split }))
+                        << "matcher " << matcher << ", split at " << split << " of " << body;
+            }
+            std::vector<size_t> splits; // random chunks
+            for (size_t split = rng() % 8; split < body.size(); split += 1 + rng() % 40) splits.push_back(split);
+            EXPECT_EQ(fixed<Boundary>(matcher, body, splits), runtime(Boundary, matcher, body, splits));
+        }
+    }
+}
+
+}
+
+TEST(FixedBoundary, SameHooksAsRuntimeBoundary) {
+    compareAtEverySplit<Short>();
+    compareAtEverySplit<Lane>();
+    compareAtEverySplit<Repeated>();
+    compareAtEverySplit<Wide>();
+    compareAtEverySplit<Longest>();
+}
+
+TEST(FixedBoundaryDeathTest, ParserWithOtherBoundary) {
+    std::string body = "--7MA4YWxkTrZu0gW\r\n\r\ndata\r\n--7MA4YWxkTrZu0gW--";
+    for (const char *boundary : { "7MA4YWxkTrZu0gX", "other" }) { // same and different length
+        multipart_parser parser;
+        multipart_parser_construct(&parser, boundary, nullptr);
+        Trace trace;
+        size_t parsed = body.size();
+        EXPECT_DEBUG_DEATH(parsed = multipart_parser_execute_fixed<Lane>(&parser, trace, body.data(), body.size()), "other boundary");
+#ifdef NDEBUG
+        EXPECT_EQ(parsed, 0);
+        EXPECT_TRUE(trace.events.empty());
+#endif
+        multipart_parser_destroy(&parser);
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/HeaderId.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+const HeaderId Known[] = { HeaderId::ContentType, HeaderId::ContentId, HeaderId::ContentDisposition,
+                           HeaderId::ContentTransferEncoding, HeaderId::ContentLength, HeaderId::ContentLocation
+                         };
+
+// Reference identification: case insensitive comparison with every well-known name
+HeaderId reference(std::string_view name) {
+    for (HeaderId id : Known) {
+        std::string_view known = headerName(id);
+        if (known.size() != name.size()) continue;
+        size_t k = 0;
+        while (k < known.size() && tolower((unsigned char)name[k]) == known[k]) k++;
+        if (k == known.size()) return id;
+    }
+    return HeaderId::Unknown;
+}
+
+static_assert(headerId("Content-Type") == HeaderId::ContentType, "identified at compile time");
+static_assert(headerId("X-Content-Type") == HeaderId::Unknown, "identified at compile time");
+
+}
+
+TEST(HeaderId, WellKnownNamesInAnyCase) {
+    std::mt19937 rng(13);
+    for (HeaderId id : Known) {
+        std::string name(headerName(id));
+        EXPECT_EQ(headerId(name), id);
+        for (char &c : name) c = toupper(c);
+        EXPECT_EQ(headerId(name), id) << name;
+        for (int variant = 0; variant < 20; variant++) {
+            for (char &c : name) c = (rng() % 2) ? toupper(c) : tolower(c);
+            EXPECT_EQ(headerId(name), id) << name;
+        }
+        EXPECT_EQ(headerName(headerId(name)), headerName(id));
+    }
+    EXPECT_EQ(headerName(HeaderId::Unknown), "");
+}
+
+TEST(HeaderId, CollisionCandidatesAreUnknown) {
+    for (HeaderId id : Known) {
+        std::string known(headerName(id));
+
+        // Same slot (length and last character), other content:
+        for (size_t k = 0; k + 1 < known.size(); k++) {
+            for (char c : { 'a', 'z', '-', 'Q', '0', '_', ' ', '\0' }) {
+                std::string name = known;
+                if (tolower(name[k]) == tolower(c)) continue;
+                name[k] = c;
+                EXPECT_EQ(headerId(name), HeaderId::Unknown) << name;
+            }
+        }
+        // Same slot, length differing by the table size:
+        EXPECT_EQ(headerId(std::string(32, 'x') + known), HeaderId::Unknown);
+        EXPECT_EQ(headerId(known.substr(0, known.size() - 1) + std::string(33, known.back())), HeaderId::Unknown);
+        // Prefixes, suffixes and surrounding blanks:
+        EXPECT_EQ(headerId(known.substr(0, known.size() - 1)), HeaderId::Unknown);
+        EXPECT_EQ(headerId(known + "s"), HeaderId::Unknown);
+        EXPECT_EQ(headerId(" " + known), HeaderId::Unknown);
+        EXPECT_EQ(headerId(known + " "), HeaderId::Unknown);
+    }
+}
+
+TEST(HeaderId, EmptyAndShortNames) {
+    EXPECT_EQ(headerId(""), HeaderId::Unknown);
+    EXPECT_EQ(headerId(std::string_view()), HeaderId::Unknown);
+    for (int c = 0; c < 256; c++) {
+        char name = (char)c;
+        EXPECT_EQ(headerId(std::string_view(&name, 1)), HeaderId::Unknown) << c;
+    }
+}
+
+TEST(HeaderId, MatchesReference) {
+    std::mt19937 rng(31);
+    const char alphabet[] = "contet-ypidsralghfCONTET-YPIDSRALGHF_ \xe9";
+    for (int iteration = 0; iteration < 200000; iteration++) {
+        std::string name;
+        if (iteration % 2) { // well-known name with a few changes
+            name = headerName(Known[rng() % 6]);
+            for (size_t changes = rng() % 3; changes > 0; changes--) {
+                name[rng() % name.size()] = alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+        }
+        else {
+            for (size_t length = rng() % 30; length > 0; length--) name += alphabet[rng() % (sizeof(alphabet) - 1)];
+        }
+        ASSERT_EQ(headerId(name), reference(name)) << name;
+    }
+}
+
+TEST(HeaderId, Parameters) {
+    std::string_view value = "multipart/related; type=\"application/xml\";Boundary = abc ; start=\"<a;b>\"";
+    EXPECT_EQ(headerParameter(value, "boundary"), "abc");
+    EXPECT_EQ(headerParameter(value, "TYPE"), "application/xml");
+    EXPECT_EQ(headerParameter(value, "start"), "<a;b>");
+    EXPECT_EQ(headerParameter(value, "charset"), "");
+    EXPECT_EQ(headerParameter("multipart/mixed", "boundary"), "");
+    EXPECT_EQ(headerParameter("", "boundary"), "");
+}
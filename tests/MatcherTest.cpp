@@ -0,0 +1,126 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/Parser.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+// Parses the body in chunks split at the given points
+std::string parse(multipart_matcher matcher, const std::string &boundary, const std::string &body, const std::vector<size_t> &splits) {
+    return traceChunked(boundary, matcher, body, splits, [](multipart_parser *parser, Trace &trace, const char *data, size_t length) {
+        return multipart_parser_execute(parser, trace, data, length);
+    });
+}
+
+struct Case {
+    std::string boundary;
+    std::string body;
+    bool wellFormed;
+};
+
+std::string part(const std::string &boundary, const std::string &data) {
+    return "--" + boundary + "\r\nContent-Type: a\r\n\r\n" + data + "\r\n";
+}
+
+std::vector<Case> cases() {
+    std::vector<Case> result;
+
+    // Delimiters (and their CR) at every position of 16 and 32 bytes lanes, for several boundary lengths
+    for (size_t length : { 1, 5, 15, 31, 70 }) {
+        std::string boundary(length, 'q');
+        for (size_t offset = 0; offset < 70; offset++) {
+            std::string data(offset, 'x');
+            result.push_back(Case{boundary, part(boundary, data) + part(boundary, "y") + "--" + boundary + "--", true});
+        }
+    }
+
+    // Boundary prefixes repeated and overlapping within part data
+    for (std::string boundary : { std::string("aaaaab"), std::string("abababc"), std::string("--x--"), std::string("7MA4YWxkTrZu0gW") }) {
+        std::string data;
+        for (size_t k = 0; k < boundary.size(); k++) {
+            data += "\r\n--" + boundary.substr(0, k);
+            data += "\r\n-" + boundary.substr(0, k) + "\r";
+        }
+        data += "\r\n--" + boundary.substr(0, boundary.size() - 1) + "\r\n--" + boundary;
+        data.back()++; // last character differs
+        result.push_back(Case{boundary, part(boundary, data) + part(boundary, data + data) + "--" + boundary + "--", true});
+    }
+
+    // Random bodies, some truncated or malformed
+    std::mt19937 rng(2021);
+    for (int n = 0; n < 40; n++) {
+        std::string boundary = std::string("7MA4YWxkTrZu0gW").substr(0, 1 + rng() % 15);
+        std::string body = randomBody(rng, boundary, 1 + rng() % 4, 150);
+        if (n % 4 == 1) body.resize(rng() % body.size());
+        if (n % 4 == 2) body[rng() % body.size()] = "\r\n-:"[rng() % 4];
+        result.push_back(Case{boundary, body, n % 4 == 0});
+    }
+    return result;
+}
+
+class Matcher : public ::testing::TestWithParam<multipart_matcher> {};
+
+}
+
+TEST_P(Matcher, SameHooksAsByteMatcherAtEverySplit) {
+    for (const Case &test : cases()) {
+        std::string expected = parse(MULTIPART_MATCHER_BYTE, test.boundary, test.body, {});
+        if (test.wellFormed) {
+            EXPECT_EQ(expected.substr(expected.size() - 12), "|Z|completed") << test.body;
+        }
+        EXPECT_EQ(parse(GetParam(), test.boundary, test.body, {}), expected);
+        for (size_t split = 0; split <= test.body.size(); split++) {
+            // fragments of malformed header lines may be delivered before the error, depending on chunks:
+            ASSERT_EQ(parse(GetParam(), test.boundary, test.body, { split }), parse(MULTIPART_MATCHER_BYTE, test.boundary, test.body, { split }))
+                    << "split at " << split << " of " << test.body;
+        }
+        std::vector<size_t> bytes; // one byte chunks
+        for (size_t split = 1; split < test.body.size(); split++) bytes.push_back(split);
+        EXPECT_EQ(parse(GetParam(), test.boundary, test.body, bytes), parse(MULTIPART_MATCHER_BYTE, test.boundary, test.body, bytes));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Parser, Matcher, ::testing::Values(MULTIPART_MATCHER_SIMD, MULTIPART_MATCHER_HORSPOOL));
@@ -0,0 +1,71 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/MultipartView.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+TEST(MultipartView, MatchesConsumer) {
+    std::mt19937 rng(8);
+    for (int iteration = 0; iteration < 200; iteration++) {
+        std::string boundary = "view";
+        std::string body = randomBody(rng, boundary, 1 + rng() % 6, 100);
+        if (iteration % 4 == 1) body.resize(rng() % body.size());
+
+        Recorder consumer(boundary);
+        bool completed = decodeChunked(consumer, body, 0);
+
+        std::string events;
+        MultipartView view(body, boundary);
+        for (const Part &part : view) {
+            for (const auto &header : part.headers) {
+                events += "[H0:" + std::string(header.first) + "=" + std::string(header.second) + "]";
+            }
+            events += std::string(part.body) + "[E0]";
+        }
+        EXPECT_EQ(view.failed(), !completed);
+        if (completed) {
+            EXPECT_EQ(events, consumer.events);
+        }
+    }
+}
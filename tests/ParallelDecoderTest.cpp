@@ -0,0 +1,231 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/ParallelDecoder.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+// Records every hook with its offset in the body (fragments of parser buffers as content)
+struct Tracer : ParserHandler {
+    const char *begin;
+    const char *end;
+    std::string events;
+    size_t hooks = 0;
+    size_t stopAt = 0; // hook returning non-zero (0: none)
+
+    Tracer(std::string_view body) : begin(body.data()), end(body.data() + body.size()) {}
+
+    int add(char tag, const char *at = nullptr, size_t length = 0) {
+        events += tag;
+        if (at && at >= begin && at < end) events += std::to_string(at - begin) + ":" + std::to_string(length);
+        else if (at) events += "[" + std::string(at, length) + "]";
+        events += ';';
+        return (++hooks == stopAt) ? 1 : 0;
+    }
+    int onPartDataBegin() {
+        return add('B');
+    }
+    int onHeaderField(const char *at, size_t length) {
+        return add('F', at, length);
+    }
+    int onHeaderValue(const char *at, size_t length) {
+        return add('V', at, length);
+    }
+    int onHeadersComplete() {
+        return add('C');
+    }
+    int onPartData(const char *at, size_t length) {
+        return add('D', at, length);
+    }
+    int onPartDataEnd() {
+        return add('E');
+    }
+    int onBodyEnd() {
+        return add('Z');
+    }
+};
+
+std::string mutate(std::mt19937 &rng, std::string body) {
+    switch (rng() % 4) {
+    case 1:
+        body[rng() % body.size()] = "\r\n-:x"[rng() % 5];
+        break;
+    case 2:
+        body.resize(rng() % body.size());
+        break;
+    default:
+        break;
+    }
+    return body;
+}
+
+}
+
+TEST(ParallelDecoder, ExecuteMatchesSerial) {
+    std::mt19937 rng(12);
+    ParallelDecoder decoders[] = { ParallelDecoder(1), ParallelDecoder(2), ParallelDecoder(4) };
+    for (int iteration = 0; iteration < 1000; iteration++) {
+        std::string boundary = std::string("7MA4YWxkTrZu0gW").substr(0, 1 + rng() % 15);
+        std::string body = mutate(rng, randomBody(rng, boundary, 1 + rng() % 12, (rng() % 3 == 0) ? 600 : 40));
+
+        multipart_parser parser;
+        multipart_parser_construct(&parser, boundary.c_str(), nullptr);
+        Tracer serial(body);
+        size_t parsed = multipart_parser_execute(&parser, serial, body.data(), body.size());
+
+        ParallelDecoder &decoder = decoders[rng() % 3];
+        decoder.setSliceSize(1 + rng() % 300);
+        Tracer parallel(body);
+        EXPECT_EQ(decoder.execute(boundary, body.data(), body.size(), parallel), parsed);
+        EXPECT_EQ(decoder.completed(), multipart_parser_completed(&parser) != 0);
+        EXPECT_EQ(parallel.events, serial.events) << "iteration " << iteration;
+
+        // Stopped by a hook: same hooks up to it
+        if (serial.hooks > 1) {
+            Tracer stopped(body);
+            stopped.stopAt = 1 + rng() % serial.hooks;
+            Tracer reference(body);
+            reference.stopAt = stopped.stopAt;
+            multipart_parser_reset(&parser, boundary.c_str());
+            size_t stop = multipart_parser_execute(&parser, reference, body.data(), body.size());
+            EXPECT_EQ(decoder.execute(boundary, body.data(), body.size(), stopped), stop);
+            EXPECT_EQ(stopped.events, reference.events);
+        }
+        multipart_parser_destroy(&parser);
+    }
+}
+
+TEST(ParallelDecoder, DecodeMatchesSerial) {
+    std::mt19937 rng(13);
+    ParallelDecoder decoder(3);
+    for (int iteration = 0; iteration < 300; iteration++) {
+        std::string boundary = "parallel";
+        std::string body = mutate(rng, randomBody(rng, boundary, 1 + rng() % 20, 2000));
+        decoder.setSliceSize(1 + rng() % 1000);
+
+        Recorder serial(boundary);
+        serial.feed(body.data(), body.size());
+        bool completed = serial.finish();
+
+        Recorder parallel(boundary);
+        decoder.decode(parallel, body.data(), body.size());
+        EXPECT_EQ(parallel.finish(), completed);
+        EXPECT_EQ(parallel.events, serial.events);
+    }
+}
+
+TEST(ParallelDecoder, DecodeBatchMatchesSerial) {
+    std::mt19937 rng(22);
+    std::string boundary = "batch";
+    std::vector<std::string> storage;
+    for (int n = 0; n < 200; n++) storage.push_back(mutate(rng, randomBody(rng, boundary, 1 + rng() % 4, 100)));
+    std::vector<std::string_view> bodies(storage.begin(), storage.end());
+
+    std::vector<std::string> expected;
+    std::vector<DecodeResult> serialResults;
+    for (const std::string &body : storage) {
+        Recorder serial(boundary);
+        serial.feed(body.data(), body.size());
+        serial.finish();
+        serialResults.push_back(serial.result());
+        expected.push_back(serial.events);
+    }
+
+    ParallelDecoder decoder(3);
+    std::vector<std::unique_ptr<Recorder>> owned;
+    std::vector<Recorder*> consumers;
+    for (size_t worker = 0; worker < decoder.workers(); worker++) {
+        owned.emplace_back(new Recorder("other")); // armed by the batch
+        consumers.push_back(owned.back().get());
+    }
+    std::vector<std::string> events(bodies.size());
+    std::function<void(Recorder&, size_t)> done = [&](Recorder &consumer, size_t body) {
+        events[body] = consumer.events;
+        consumer.events.clear();
+    };
+    for (int round = 0; round < 2; round++) {
+        const auto &results = decoder.decodeBatch(boundary, bodies.data(), bodies.size(), consumers, done);
+        ASSERT_EQ(results.size(), bodies.size());
+        for (size_t n = 0; n < bodies.size(); n++) {
+            EXPECT_EQ(results[n].status, serialResults[n].status);
+            EXPECT_EQ(results[n].offset, serialResults[n].offset);
+            EXPECT_EQ(events[n], expected[n]) << "body " << n;
+        }
+    }
+}
+
+TEST(ParallelDecoder, DecodeBatchWithoutConsumers) {
+    std::string body = "--B\r\n\r\ndata\r\n--B--";
+    std::vector<std::string_view> bodies(3, body);
+    ParallelDecoder decoder(2);
+    std::vector<Recorder*> consumers;
+    EXPECT_TRUE(decoder.decodeBatch("B", bodies.data(), bodies.size(), consumers).empty());
+}
+
+TEST(ParallelDecoder, DecodeStoppedByLimit) {
+    std::mt19937 rng(23);
+    ParallelDecoder decoder(3);
+    for (int iteration = 0; iteration < 200; iteration++) {
+        std::string boundary = "limited";
+        std::string body = randomBody(rng, boundary, 2 + rng() % 20, 2000);
+        DecodeLimits limits;
+        limits.parts = 1 + rng() % 10;
+        if (rng() % 2) limits.partSize = rng() % 1500;
+        decoder.setSliceSize(1 + rng() % 1000);
+
+        Recorder serial(boundary);
+        serial.setLimits(limits);
+        serial.feed(body.data(), body.size());
+
+        Recorder parallel(boundary);
+        parallel.setLimits(limits);
+        decoder.decode(parallel, body.data(), body.size());
+        EXPECT_EQ(parallel.result().status, serial.result().status);
+        EXPECT_EQ(parallel.result().offset, serial.result().offset);
+        EXPECT_EQ(parallel.events, serial.events);
+    }
+}
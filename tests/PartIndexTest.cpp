@@ -0,0 +1,87 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/PartIndex.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+const std::string Related = "--B\r\nContent-Type: application/xml\r\nContent-ID: <root>\r\n\r\n<a/>\r\n"
+                            "--B\r\nContent-ID: <n1msg>\r\nContent-Location: http://x/n1\r\n\r\nfirst\r\n"
+                            "--B\r\nContent-ID: cid:n2msg\r\n\r\nsecond\r\n--B--";
+
+}
+
+TEST(PartIndex, Lookups) {
+    PartIndex index;
+    ASSERT_TRUE(index.build(Related, "B"));
+    ASSERT_EQ(index.size(), 3u);
+    EXPECT_EQ(index.view(index.at(1)->body), "first");
+    EXPECT_EQ(index.at(3), nullptr);
+
+    ASSERT_NE(index.findById("n1msg"), nullptr);
+    EXPECT_EQ(index.findById("<n1msg>"), index.at(1));
+    EXPECT_EQ(index.findById("cid:n2msg"), index.at(2));
+    EXPECT_EQ(index.findById("missing"), nullptr);
+    EXPECT_EQ(index.findByLocation(" http://x/n1"), index.at(1));
+
+    EXPECT_EQ(index.root("multipart/related; start=\"<n2msg>\""), index.at(2));
+    EXPECT_EQ(index.root("multipart/related"), index.at(0));
+}
+
+TEST(PartIndex, LookupsAfterBodyMoved) {
+    std::string body = Related;
+    PartIndex index;
+    ASSERT_TRUE(index.build(body, "B"));
+
+    // body relocated (as in a reallocated container): the former buffer is overwritten and released
+    std::string moved(body.data(), body.size());
+    std::fill(body.begin(), body.end(), 'x');
+    body.clear();
+    body.shrink_to_fit();
+
+    const IndexedPart *part = index.findById("n2msg");
+    ASSERT_NE(part, nullptr);
+    EXPECT_EQ(PartIndex::view(moved, part->body), "second");
+    EXPECT_EQ(index.findByLocation("http://x/n1"), index.at(1));
+    EXPECT_EQ(index.root("multipart/related; start=root"), index.at(0));
+}
@@ -0,0 +1,113 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/MultipartView.hpp>
+#include <ert/multipart/Producer.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+std::vector<std::string> decode(const std::string &body, const std::string &boundary) {
+    std::vector<std::string> result;
+    MultipartView view(body, boundary);
+    for (const auto &part : view) result.emplace_back(part.body);
+    if (view.failed()) result.push_back("<malformed>");
+    return result;
+}
+
+std::string gather(const std::vector<iovec> &iovecs) {
+    std::string result;
+    for (const iovec &vector : iovecs) result.append((const char*)vector.iov_base, vector.iov_len);
+    return result;
+}
+
+}
+
+TEST(Producer, EncodeMatchesIovecs) {
+    std::string json = "{\"a\":1}";
+    std::string binary("\0\r\n--x", 6);
+    Producer producer;
+    producer.addPart({{"Content-Type", "application/json"}}, json);
+    producer.addPart({}, "");
+    producer.addPart({{"Content-Type", "application/octet-stream"}, {"Content-ID", "<b>"}}, binary);
+
+    std::string body = producer.encode();
+    EXPECT_EQ(body.size(), producer.size());
+    EXPECT_EQ(gather(producer.iovecs()), body);
+    EXPECT_EQ(gather(producer.iovecs()), body); // buffers rebuilt in place
+    EXPECT_EQ(decode(body, producer.boundary()), (std::vector<std::string> { json, "", binary }));
+}
+
+TEST(Producer, GeneratedBoundaryIsStable) {
+    Producer producer;
+    producer.addPart({}, "first");
+    std::string boundary = producer.boundary();
+    EXPECT_EQ(boundary.size(), 32u);
+    producer.addPart({}, "second");
+    EXPECT_EQ(producer.boundary(), boundary);
+    producer.encode();
+    EXPECT_EQ(producer.boundary(), boundary);
+
+    producer.clear();
+    producer.addPart({}, "third");
+    EXPECT_NE(producer.boundary(), boundary);
+}
+
+TEST(Producer, CollidingPartRegeneratesBoundary) {
+    Producer producer;
+    producer.addPart({}, "first");
+    std::string collision = "data\r\n--" + producer.boundary() + "\r\nmore";
+    producer.addPart({}, collision);
+    std::string boundary = producer.boundary();
+    EXPECT_EQ(collision.find(boundary), std::string::npos);
+
+    std::string body = producer.encode();
+    EXPECT_EQ(decode(body, boundary), (std::vector<std::string> { "first", collision }));
+    EXPECT_EQ(gather(producer.iovecs()), body);
+}
+
+TEST(Producer, FixedBoundary) {
+    Producer producer("fixed");
+    producer.addPart({{"X", "1"}}, "data");
+    EXPECT_EQ(producer.boundary(), "fixed");
+    EXPECT_EQ(producer.encode(), "--fixed\r\nX: 1\r\n\r\ndata\r\n--fixed--\r\n");
+}
@@ -0,0 +1,214 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/MultipartView.hpp>
+#include <ert/multipart/Rewriter.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+std::string gather(const std::vector<iovec> &iovecs) {
+    std::string result;
+    for (const iovec &vector : iovecs) result.append((const char*)vector.iov_base, vector.iov_len);
+    return result;
+}
+
+bool inside(const std::string &body, const iovec &vector) {
+    const char *base = (const char*)vector.iov_base;
+    return base >= body.data() && base + vector.iov_len <= body.data() + body.size();
+}
+
+const std::string Body = "--B\r\nContent-Type: text/plain\r\nX-A: \t1\r\n\r\nhello\r\n--B\r\n\r\n\r\n"
+                         "--B\r\nContent-ID: <x>\r\nx-a: 2\r\nX-A: 3\r\n\r\nworld\r\nwith\r\n--B--\r\nepilogue";
+
+}
+
+TEST(Rewriter, RoundTrip) {
+    Rewriter rewriter;
+    ASSERT_TRUE(rewriter.load(Body, "B"));
+    EXPECT_EQ(rewriter.parts(), 3u);
+    EXPECT_EQ(rewriter.body(0), "hello");
+    EXPECT_EQ(rewriter.body(1), "");
+    EXPECT_EQ(rewriter.body(2), "world\r\nwith");
+    EXPECT_EQ(rewriter.header(0, "x-a"), "\t1");
+    EXPECT_EQ(rewriter.header(2, "content-id"), "<x>");
+
+    EXPECT_EQ(rewriter.encode(), Body);
+    EXPECT_EQ(rewriter.size(), Body.size());
+    ASSERT_EQ(rewriter.iovecs().size(), 1u);
+    EXPECT_TRUE(inside(Body, rewriter.iovecs()[0]));
+}
+
+TEST(Rewriter, Edits) {
+    Rewriter rewriter;
+    ASSERT_TRUE(rewriter.load(Body, "B"));
+
+    rewriter.dropPart(1);
+    std::string expected = "--B\r\nContent-Type: text/plain\r\nX-A: \t1\r\n\r\nhello\r\n"
+                           "--B\r\nContent-ID: <x>\r\nx-a: 2\r\nX-A: 3\r\n\r\nworld\r\nwith\r\n--B--\r\nepilogue";
+    EXPECT_EQ(rewriter.encode(), expected);
+    EXPECT_EQ(rewriter.iovecs().size(), 2u);
+    EXPECT_EQ(gather(rewriter.iovecs()), expected);
+
+    std::string replacement = "NEW";
+    rewriter.replaceBody(0, replacement);
+    rewriter.setHeader(2, "X-a", "9");
+    rewriter.removeHeader(2, "content-id");
+    rewriter.setHeader(2, "Y", "y");
+    expected = "--B\r\nContent-Type: text/plain\r\nX-A: \t1\r\n\r\nNEW\r\n"
+               "--B\r\nx-a: 9\r\nY: y\r\n\r\nworld\r\nwith\r\n--B--\r\nepilogue";
+    EXPECT_EQ(rewriter.encode(), expected);
+    EXPECT_EQ(gather(rewriter.iovecs()), expected);
+    EXPECT_EQ(rewriter.size(), expected.size());
+
+    rewriter.insertPart(0, {{"A", "b"}}, "first");
+    rewriter.insertPart(3, {}, "last");
+    rewriter.replacePart(1, {{"K", "v"}}, "kv");
+    expected = "--B\r\nA: b\r\n\r\nfirst\r\n--B\r\nContent-Type: text/plain\r\nX-A: \t1\r\n\r\nNEW\r\n"
+               "--B\r\nK: v\r\n\r\nkv\r\n--B\r\nx-a: 9\r\nY: y\r\n\r\nworld\r\nwith\r\n"
+               "--B\r\n\r\nlast\r\n--B--\r\nepilogue";
+    EXPECT_EQ(rewriter.encode(), expected);
+    EXPECT_EQ(gather(rewriter.iovecs()), expected);
+
+    size_t parts = 0;
+    MultipartView view(expected, "B");
+    for (const auto &part : view) {
+        (void)part;
+        parts++;
+    }
+    EXPECT_EQ(parts, 5u);
+    EXPECT_FALSE(view.failed());
+
+    rewriter.revert();
+    EXPECT_EQ(rewriter.encode(), Body);
+    EXPECT_FALSE(rewriter.dropPart(3));
+    EXPECT_TRUE(rewriter.insertPart(3, {}, ""));
+}
+
+TEST(Rewriter, MalformedBodyIsKept) {
+    Rewriter rewriter;
+    EXPECT_FALSE(rewriter.load("--B\r\nX: 1\r\n\r\nxx", "B"));
+    EXPECT_EQ(rewriter.encode(), "--B\r\nX: 1\r\n\r\nxx");
+    EXPECT_FALSE(rewriter.dropPart(0));
+    EXPECT_FALSE(rewriter.insertPart(0, {}, "x"));
+}
+
+TEST(Rewriter, HeaderLinesWithoutColon) {
+    // a line without colon ends the headers, as for the parser
+    std::string body = "--B\r\nX: 1\r\nplain\r\nY: 2\r\n\r\ndata\r\n--B--";
+    Rewriter rewriter;
+    ASSERT_TRUE(rewriter.load(body, "B"));
+    std::vector<std::string> bodies;
+    for (const auto &part : MultipartView(body, "B")) bodies.emplace_back(part.body);
+    ASSERT_EQ(bodies.size(), 1u);
+    EXPECT_EQ(rewriter.body(0), bodies[0]);
+    EXPECT_EQ(rewriter.header(0, "x"), "1");
+    EXPECT_EQ(rewriter.header(0, "y"), "");
+}
+
+TEST(Rewriter, ColonsInBodyAreNotHeaders) {
+    std::string body = "--B\r\n\r\nkey: value\r\n--B\r\nX: 1\r\n\r\na:b\r\n--B--";
+    Rewriter rewriter;
+    ASSERT_TRUE(rewriter.load(body, "B"));
+    EXPECT_EQ(rewriter.body(0), "key: value");
+    EXPECT_EQ(rewriter.header(0, "key"), "");
+    EXPECT_EQ(rewriter.body(1), "a:b");
+    EXPECT_EQ(rewriter.header(1, "x"), "1");
+    rewriter.setHeader(0, "Y", "2");
+    EXPECT_EQ(rewriter.encode(), "--B\r\nY: 2\r\n\r\nkey: value\r\n--B\r\nX: 1\r\n\r\na:b\r\n--B--");
+}
+
+TEST(Rewriter, RandomEditsMatchReference) {
+    std::mt19937 rng(5);
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        std::string body;
+        size_t count = 1 + rng() % 6;
+        for (size_t n = 0; n < count; n++) {
+            body += "--bb\r\n";
+            for (size_t header = rng() % 3; header > 0; header--) {
+                body += std::string("H") + char('a' + header) + ": v" + std::to_string(n) + "\r\n";
+            }
+            body += "\r\n";
+            for (size_t length = rng() % 20; length > 0; length--) body += "ab\r\n-"[rng() % 5];
+            body += "\r\n";
+        }
+        body += "--bb--";
+
+        Rewriter rewriter;
+        if (!rewriter.load(body, "bb")) {
+            continue;
+        }
+        std::vector<std::string> bodies;
+        for (const auto &part : MultipartView(body, "bb")) bodies.emplace_back(part.body);
+        ASSERT_EQ(rewriter.parts(), bodies.size());
+
+        std::vector<std::string> expected;
+        std::vector<std::string> replacements(bodies.size());
+        for (size_t n = 0; n < bodies.size(); n++) {
+            EXPECT_EQ(rewriter.body(n), bodies[n]);
+            switch (rng() % 4) {
+            case 0:
+                rewriter.dropPart(n);
+                break;
+            case 1:
+                replacements[n] = "R" + std::to_string(n);
+                rewriter.replaceBody(n, replacements[n]);
+                expected.push_back(replacements[n]);
+                break;
+            case 2:
+                rewriter.setHeader(n, "Ha", "z");
+                expected.push_back(bodies[n]);
+                break;
+            default:
+                expected.push_back(bodies[n]);
+                break;
+            }
+        }
+
+        std::string output = gather(rewriter.iovecs());
+        EXPECT_EQ(output, rewriter.encode());
+        std::vector<std::string> decoded;
+        for (const auto &part : MultipartView(output, "bb")) decoded.emplace_back(part.body);
+        EXPECT_EQ(decoded, expected) << "iteration " << iteration;
+    }
+}
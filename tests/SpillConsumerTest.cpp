@@ -0,0 +1,216 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/SpillConsumer.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+struct Received {
+    std::string data;
+    bool spilled;
+    std::string path; // kept files only
+};
+
+class SpillRecorder : public SpillConsumer {
+public:
+    std::vector<Received> parts;
+    bool keep = false;
+    SpillRecorder(const std::string &boundary, const std::string &directory, size_t threshold) : SpillConsumer(boundary) {
+        setSpillDirectory(directory);
+        setSpillThreshold(threshold);
+    }
+    void receiveSpilledPart(SpilledPart &part) override {
+        EXPECT_FALSE(part.failed());
+        EXPECT_EQ(part.view().size(), part.size());
+        parts.push_back({ std::string(part.view()), part.spilled(), "" });
+        if (keep && part.spilled()) {
+            part.keep();
+            parts.back().path = part.path();
+        }
+    }
+};
+
+// Temporary directory for spilled files, removed with its files
+class SpillDirectory {
+public:
+    std::string path;
+    SpillDirectory() {
+        char name[] = "/tmp/spill-test-XXXXXX";
+        path = mkdtemp(name);
+    }
+    ~SpillDirectory() {
+        for (const std::string &file : files()) unlink((path + "/" + file).c_str());
+        rmdir(path.c_str());
+    }
+    std::vector<std::string> files() const {
+        std::vector<std::string> result;
+        DIR *dir = opendir(path.c_str());
+        while (struct dirent *entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') result.emplace_back(entry->d_name);
+        }
+        closedir(dir);
+        return result;
+    }
+};
+
+std::string body(const std::string &boundary, const std::vector<std::string> &parts) {
+    std::string result;
+    for (const std::string &part : parts) result += "--" + boundary + "\r\nContent-Type: application/octet-stream\r\n\r\n" + part + "\r\n";
+    return result + "--" + boundary + "--";
+}
+
+}
+
+TEST(SpillConsumer, SpillsLargeParts) {
+    std::mt19937 rng(18);
+    SpillDirectory directory;
+    std::string large(3 * SpillConsumer::WriteSize + 17, 0);
+    for (char &c : large) {
+        c = (char)(rng() % 256);
+        if (c == '\r') c = '\n'; // no delimiter
+    }
+    std::vector<std::string> parts = { "", "small", randomData(rng, 5000, "spill"), large };
+    std::string multipart = body("spill", parts);
+
+    for (size_t chunk : { (size_t)0, (size_t)1000, (size_t)(SpillConsumer::WriteSize + 1) }) {
+        SpillRecorder consumer("spill", directory.path, 1000);
+        EXPECT_TRUE(decodeChunked(consumer, multipart, chunk));
+        ASSERT_EQ(consumer.parts.size(), parts.size());
+        for (size_t k = 0; k < parts.size(); k++) {
+            EXPECT_EQ(consumer.parts[k].data, parts[k]) << "part " << k << ", chunk " << chunk; // mapped files read back
+            EXPECT_EQ(consumer.parts[k].spilled, parts[k].size() > 1000);
+        }
+        EXPECT_TRUE(directory.files().empty()); // removed after the callback
+    }
+}
+
+TEST(SpillConsumer, ThresholdCrossing) {
+    std::mt19937 rng(180);
+    SpillDirectory directory;
+    size_t threshold = 64;
+    std::vector<std::string> parts;
+    for (size_t size : { threshold - 1, threshold, threshold + 1, 2 * threshold }) parts.push_back(randomData(rng, size, "edge"));
+    std::string multipart = body("edge", parts);
+
+    for (size_t chunk : { (size_t)0, (size_t)1, (size_t)7, (size_t)threshold }) {
+        SpillRecorder consumer("edge", directory.path, threshold);
+        EXPECT_TRUE(decodeChunked(consumer, multipart, chunk));
+        ASSERT_EQ(consumer.parts.size(), parts.size());
+        for (size_t k = 0; k < parts.size(); k++) {
+            EXPECT_EQ(consumer.parts[k].data, parts[k]);
+            EXPECT_EQ(consumer.parts[k].spilled, parts[k].size() > threshold) << "size " << parts[k].size() << ", chunk " << chunk;
+        }
+    }
+
+    // Every part with data spilled:
+    SpillRecorder consumer("edge", directory.path, 0);
+    EXPECT_TRUE(decodeChunked(consumer, body("edge", { "", "x" }), 0));
+    ASSERT_EQ(consumer.parts.size(), 2);
+    EXPECT_FALSE(consumer.parts[0].spilled);
+    EXPECT_TRUE(consumer.parts[1].spilled);
+}
+
+TEST(SpillConsumer, KeptFiles) {
+    std::mt19937 rng(1800);
+    SpillDirectory directory;
+    std::string data = randomData(rng, 10000, "keep");
+
+    SpillRecorder consumer("keep", directory.path, 100);
+    consumer.keep = true;
+    EXPECT_TRUE(decodeChunked(consumer, body("keep", { data }), 333));
+    ASSERT_EQ(consumer.parts.size(), 1);
+    ASSERT_FALSE(consumer.parts[0].path.empty());
+
+    std::ifstream file(consumer.parts[0].path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), data);
+    EXPECT_EQ(directory.files().size(), 1);
+}
+
+TEST(SpillConsumer, ResetMidPart) {
+    std::mt19937 rng(18000);
+    SpillDirectory directory;
+    std::string multipart = body("mid", { randomData(rng, 10000, "mid") });
+    std::string next = body("mid", { "after" });
+
+    SpillRecorder consumer("mid", directory.path, 100);
+
+    // Through the virtual callbacks class:
+    Consumer &base = consumer;
+    base.feed(multipart.data(), multipart.size() / 2);
+    EXPECT_EQ(directory.files().size(), 1);
+    EXPECT_TRUE(base.reset("mid"));
+    EXPECT_TRUE(directory.files().empty());
+    EXPECT_TRUE(decodeChunked(base, next, 0));
+
+    // Through the statically dispatched one:
+    BasicConsumer<Consumer> &basic = consumer;
+    basic.rewind();
+    basic.feed(multipart.data(), multipart.size() / 2);
+    EXPECT_EQ(directory.files().size(), 1);
+    basic.rewind();
+    EXPECT_TRUE(directory.files().empty());
+    EXPECT_TRUE(decodeChunked(basic, next, 0));
+
+    ASSERT_EQ(consumer.parts.size(), 2);
+    EXPECT_EQ(consumer.parts[0].data, "after");
+    EXPECT_EQ(consumer.parts[1].data, "after");
+
+    // Destroyed mid part:
+    {
+        SpillRecorder abandoned("mid", directory.path, 100);
+        abandoned.feed(multipart.data(), multipart.size() / 2);
+        EXPECT_EQ(directory.files().size(), 1);
+    }
+    EXPECT_TRUE(directory.files().empty());
+}
@@ -0,0 +1,171 @@
+/*
+ ______________________________________________________________________
+|            _                          _ _   _                  _     |
+|           | |                        | | | (_)                | |    |
+|   ___ _ __| |_   __   _ __ ___  _   _| | |_ _ _ __   __ _ _ __| |_   | Multipart parser library C++
+|  / _ \ '__| __| |__| | '_ ` _ \| | | | | __| | '_ \ / _` | '__| __|  | Forked and modified from https://github.com/iafonov/multipart-parser-c
+| |  __/ |  | |_       | | | | | | |_| | | |_| | |_) | (_| | |  | |_   | Version 1.0.z
+|  \___|_|   \__|      |_| |_| |_|\__,_|_|\__|_| .__/ \__,_|_|   \__|  | https://github.com/testillano/multipart
+|                                              | |                     |
+|                                              |_|                     |
+|______________________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2022 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ert/multipart/TransferDecoder.hpp>
+
+#include <Bodies.hpp>
+
+using namespace ert::multipart;
+
+
+namespace {
+
+// Reference encoders (RFC 2045), with line breaks
+std::string base64(const std::string &data, size_t line) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    size_t column = 0;
+    for (size_t k = 0; k < data.size(); k += 3) {
+        uint32_t bits = (unsigned char)data[k] << 16;
+        if (k + 1 < data.size()) bits |= (unsigned char)data[k + 1] << 8;
+        if (k + 2 < data.size()) bits |= (unsigned char)data[k + 2];
+        result += alphabet[(bits >> 18) & 63];
+        result += alphabet[(bits >> 12) & 63];
+        result += (k + 1 < data.size()) ? alphabet[(bits >> 6) & 63] : '=';
+        result += (k + 2 < data.size()) ? alphabet[bits & 63] : '=';
+        if (line && (column += 4) >= line) {
+            result += "\r\n";
+            column = 0;
+        }
+    }
+    return result;
+}
+
+std::string quotedPrintable(const std::string &data) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string result;
+    size_t column = 0;
+    for (char c : data) {
+        if (column > 70) { // soft line break
+            result += "=\r\n";
+            column = 0;
+        }
+        unsigned char u = (unsigned char)c;
+        if (u >= 33 && u <= 126 && u != '=') {
+            result += c;
+            column++;
+        }
+        else {
+            result += '=';
+            result += hex[u >> 4];
+            result += hex[u & 15];
+            column += 3;
+        }
+    }
+    return result;
+}
+
+// Decodes in random fragments
+std::string decode(TransferEncoding encoding, const std::string &encoded, std::mt19937 &rng) {
+    TransferDecoder decoder;
+    decoder.reset(encoding);
+    std::string result;
+    std::string output;
+    for (size_t offset = 0; offset < encoded.size();) {
+        size_t length = std::min((size_t)(1 + rng() % 100), encoded.size() - offset);
+        output.resize(TransferDecoder::bound(length));
+        result.append(output.data(), decoder.decode(encoded.data() + offset, length, &output[0]));
+        offset += length;
+    }
+    output.resize(TransferDecoder::bound(0));
+    result.append(output.data(), decoder.finish(&output[0]));
+    return result;
+}
+
+// Decodes base64 parts (in coalesced parts mode)
+class DecodingRecorder : public BasicConsumer<DecodingRecorder> {
+public:
+    std::vector<std::string> parts;
+    DecodingRecorder(const std::string &boundary) : BasicConsumer(boundary) {
+        setTransferDecoding(true);
+        setCoalescedParts(true);
+    }
+    void receivePartView(std::string_view data) {
+        parts.emplace_back(data);
+    }
+};
+
+}
+
+TEST(TransferDecoder, Encoding) {
+    EXPECT_EQ(transferEncoding("base64"), TransferEncoding::Base64);
+    EXPECT_EQ(transferEncoding(" BASE64 "), TransferEncoding::Base64);
+    EXPECT_EQ(transferEncoding("quoted-printable"), TransferEncoding::QuotedPrintable);
+    EXPECT_EQ(transferEncoding("binary"), TransferEncoding::Identity);
+}
+
+TEST(TransferDecoder, Base64MatchesReference) {
+    std::mt19937 rng(17);
+    for (int iteration = 0; iteration < 500; iteration++) {
+        std::string data = randomData(rng, rng() % 2000, "x");
+        for (size_t line : { (size_t)0, (size_t)76, (size_t)(4 * (1 + rng() % 20)) }) {
+            EXPECT_EQ(decode(TransferEncoding::Base64, base64(data, line), rng), data) << "line " << line;
+        }
+    }
+}
+
+TEST(TransferDecoder, QuotedPrintableMatchesReference) {
+    std::mt19937 rng(18);
+    for (int iteration = 0; iteration < 500; iteration++) {
+        std::string data = randomData(rng, rng() % 2000, "x");
+        EXPECT_EQ(decode(TransferEncoding::QuotedPrintable, quotedPrintable(data), rng), data);
+    }
+    EXPECT_EQ(decode(TransferEncoding::QuotedPrintable, "a=3Db=\r\nc=zz=", rng), "a=bc=zz=");
+}
+
+TEST(TransferDecoder, ConsumerDecodesParts) {
+    std::mt19937 rng(19);
+    for (int iteration = 0; iteration < 100; iteration++) {
+        std::string first = randomData(rng, rng() % 1000, "p=rt");
+        std::string second = randomData(rng, rng() % 1000, "p=rt");
+        std::string body = "--p=rt\r\nContent-Transfer-Encoding: base64\r\n\r\n" + base64(first, 76) + "\r\n"
+                           "--p=rt\r\nContent-Transfer-Encoding: quoted-printable\r\n\r\n" + quotedPrintable(second) + "\r\n"
+                           "--p=rt\r\n\r\n" + second + "\r\n--p=rt--";
+
+        for (size_t chunk : { (size_t)0, (size_t)1, (size_t)(1 + rng() % 128) }) {
+            DecodingRecorder consumer("p=rt");
+            EXPECT_TRUE(decodeChunked(consumer, body, chunk));
+            ASSERT_EQ(consumer.parts.size(), 3u);
+            EXPECT_EQ(consumer.parts[0], first);
+            EXPECT_EQ(consumer.parts[1], second);
+            EXPECT_EQ(consumer.parts[2], second);
+        }
+    }
+}